@@ -11,6 +11,7 @@
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
 #include "G4ThreeVector.hh"
+#include "G4Allocator.hh"
 
 class G4VProcess;
 
@@ -19,6 +20,9 @@ class BDCrossing: public G4VHit {
         BDCrossing();
         ~BDCrossing();
 
+        inline void* operator new(size_t);
+        inline void  operator delete(void*);
+
     public:
         void SetPDG(G4int);
         void SetDetID(G4int);
@@ -29,6 +33,7 @@ class BDCrossing: public G4VHit {
         void SetAngle(G4ThreeVector);
         void SetFluence(G4ThreeVector, G4double);
         void SetCreatorProcess(G4int);
+        void SetWeight(G4double);
 
         G4int GetPDG() const;
         G4int GetDetID() const;
@@ -39,6 +44,7 @@ class BDCrossing: public G4VHit {
         G4double GetAngle() const;
         G4double GetFluence() const;
         G4int GetProcessID() const;
+        G4double GetWeight() const;
 
     private:
         G4int fPdg;
@@ -50,9 +56,21 @@ class BDCrossing: public G4VHit {
         G4double fAngle;
         G4double fFluence;
         G4int fProcid;
+        G4double fWeight;
         
 };
 
 typedef G4THitsCollection<BDCrossing> BDXCollection;
 
+extern G4ThreadLocal G4Allocator<BDCrossing>* BDCrossingAllocator;
+
+inline void* BDCrossing::operator new(size_t) {
+    if (!BDCrossingAllocator) BDCrossingAllocator = new G4Allocator<BDCrossing>;
+    return (void*) BDCrossingAllocator->MallocSingle();
+}
+
+inline void BDCrossing::operator delete(void* bdx) {
+    BDCrossingAllocator->FreeSingle((BDCrossing*) bdx);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef BOUNDARY_CACHE_H
+#define BOUNDARY_CACHE_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for BoundaryCache class - per-volume surface data for
+// boundary-crossing (BDX) scoring. The surface area of each sensitive
+// solid is computed once, and for boxes the crossed face is found from
+// the local position alone, without asking the solid for its normal.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+class G4LogicalVolume;
+class G4VSolid;
+
+class BoundaryCache {
+    public:
+        BoundaryCache();
+        ~BoundaryCache();
+
+    public:
+        struct Entry {
+            const G4VSolid* solid;      // null until first use
+            G4bool isBox;
+            G4ThreeVector halfLength;   // boxes only
+            G4double halfArea;          // half the surface area, as used for fluence
+        };
+
+        // Filled on the first crossing into each volume
+        const Entry& Get(const G4LogicalVolume*);
+        // Outward normal at a point on the surface, in the solid's frame
+        G4ThreeVector GetNormal(const Entry&, const G4ThreeVector&) const;
+
+    private:
+        void Fill(Entry&, const G4VSolid*) const;
+
+    private:
+        std::vector<Entry> fEntries;    // indexed by G4LogicalVolume instance ID
+};
+
+#endif
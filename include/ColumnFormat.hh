@@ -0,0 +1,68 @@
+#ifndef COLUMN_FORMAT_H
+#define COLUMN_FORMAT_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ColumnFormat - storage of a real-valued ntuple column.
+// Values are given in double precision and stored as a double, a float,
+// or a fixed-point integer counting steps of a declared scale. The table
+// gives the format of every booked column; unlisted columns are doubles.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "globals.hh"
+
+enum ColumnStorage {
+    kStoreDouble,
+    kStoreFloat,
+    kStoreFixed
+};
+
+struct ColumnFormat {
+    ColumnFormat() : storage(kStoreDouble), scale(1.) {}
+
+    G4int Quantize(G4double value) const {
+        G4double counts = std::floor(value/scale + 0.5);
+        if (counts > std::numeric_limits<G4int>::max()) return std::numeric_limits<G4int>::max();
+        if (counts < std::numeric_limits<G4int>::min()) return std::numeric_limits<G4int>::min();
+        return static_cast<G4int>(counts);
+    }
+
+    G4int storage;      // ColumnStorage
+    G4double scale;     // value of one count of a fixed-point column
+};
+
+class ColumnFormatTable {
+    public:
+        void Clear();
+        void Set(G4int, G4int, const ColumnFormat&);
+        const ColumnFormat& Get(G4int, G4int) const;
+
+    private:
+        std::vector<std::vector<ColumnFormat> > fFormats;     // [ntuple][column]
+        ColumnFormat fDefault;
+};
+
+inline void ColumnFormatTable::Clear() {
+    fFormats.clear();
+}
+
+inline void ColumnFormatTable::Set(G4int ntuple, G4int column, const ColumnFormat& format) {
+    if (ntuple >= static_cast<G4int>(fFormats.size())) fFormats.resize(ntuple + 1);
+    if (column >= static_cast<G4int>(fFormats[ntuple].size())) fFormats[ntuple].resize(column + 1);
+    fFormats[ntuple][column] = format;
+}
+
+inline const ColumnFormat& ColumnFormatTable::Get(G4int ntuple, G4int column) const {
+    if (ntuple >= static_cast<G4int>(fFormats.size())) return fDefault;
+    if (column >= static_cast<G4int>(fFormats[ntuple].size())) return fDefault;
+    return fFormats[ntuple][column];
+}
+
+#endif
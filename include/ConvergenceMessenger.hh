@@ -0,0 +1,39 @@
+#ifndef CONVERGENCE_MESSENGER_H
+#define CONVERGENCE_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ConvergenceMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class ConvergenceMonitor;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+class ConvergenceMessenger : public G4UImessenger {
+    public:
+        ConvergenceMessenger(ConvergenceMonitor*);
+        ~ConvergenceMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        ConvergenceMonitor*      fMonitor;
+        G4UIdirectory*           fDirectory;
+        G4UIcmdWithAString*      fTallyCmd;
+        G4UIcmdWithoutParameter* fClearTalliesCmd;
+        G4UIcmdWithADouble*      fPrecisionCmd;
+        G4UIcmdWithAnInteger*    fIntervalCmd;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef CONVERGENCE_MONITOR_H
+#define CONVERGENCE_MONITOR_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ConvergenceMonitor class - follows the relative error of
+// chosen per-event tallies while the run goes on, reports it with the
+// figure of merit 1/(R^2 T), and ends the run once every tally reaches the
+// target precision. Workers publish their sums every few events; between
+// publications the only shared access is a lock-free read of the stop flag.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "globals.hh"
+
+class ConvergenceMessenger;
+class TallyAccumulable;
+
+class ConvergenceMonitor {
+    public:
+        static ConvergenceMonitor* Instance();
+
+    public:
+        // Master thread
+        void BeginOfRun();
+        void Report(const TallyAccumulable&) const;
+        // Every thread
+        void ResetLocal();
+        // Worker threads, at the end of each event
+        void EndEvent(const std::vector<G4double>&);
+        G4bool IsStopRequested() const;
+
+        // Tallies are columns of the Events ntuple
+        std::size_t GetNumberOfTallies() const;
+        G4int GetTallyColumn(std::size_t) const;
+        void AddTally(const G4String&);
+        void ClearTallies();
+        void SetPrecision(G4double);
+        void SetInterval(G4int);
+
+    private:
+        ConvergenceMonitor();
+        ~ConvergenceMonitor();
+        void Publish();
+        G4double GetElapsedTime() const;
+
+    private:
+        ConvergenceMessenger* fMessenger;
+        std::vector<G4String> fTallyNames;
+        std::vector<G4int> fTallyColumns;
+        G4double fPrecision;            // target relative error, 0 to never stop
+        G4int fInterval;                // events per worker between publications
+
+        // Run totals so far, guarded by a mutex
+        G4double fEvents;
+        std::vector<G4double> fSum;
+        std::vector<G4double> fSum2;
+        std::atomic<bool> fStopRequested;
+        std::chrono::steady_clock::time_point fStartTime;
+};
+
+inline G4bool ConvergenceMonitor::IsStopRequested() const {
+    return fStopRequested.load(std::memory_order_relaxed);
+}
+
+inline std::size_t ConvergenceMonitor::GetNumberOfTallies() const { return fTallyColumns.size(); }
+inline G4int ConvergenceMonitor::GetTallyColumn(std::size_t ii) const { return fTallyColumns[ii]; }
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef CR39_SCORER_H
+#define CR39_SCORER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for Cr39Scorer class - counts charged particles entering
+// each layer of each Cr-39 stack, by species, and histograms their LET
+// (energy deposited over path length in the layer). Writes a count table
+// and a LET score file at the end of the run.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+#include "RunScorer.hh"
+#include "DenseAccumulator.hh"
+
+class Cr39ScorerMessenger;
+class G4Step;
+class G4LogicalVolume;
+
+enum Cr39Species {
+    kCr39Muon,
+    kCr39Electron,
+    kCr39Proton,
+    kCr39OtherCharged,
+    kCr39NSpecies
+};
+
+class Cr39Scorer : public RunScorer {
+    public:
+        static Cr39Scorer* Instance();
+
+    public:
+        // Master thread
+        virtual void BeginOfRun();
+        virtual void Write(G4int) const;
+        // Every thread
+        virtual void ResetLocal();
+        virtual void Merge();
+        void Score(const G4Step*) const;
+
+        G4bool IsEnabled() const;
+        void SetEnabled(G4bool);
+        void SetLETBinning(G4int, G4double, G4double);
+
+    private:
+        Cr39Scorer();
+        ~Cr39Scorer();
+        void CloseSegment() const;
+
+    private:
+        Cr39ScorerMessenger* fMessenger;
+        G4bool fEnabled;
+        G4int fNLET;
+        G4double fLETMin, fLETMax;      // keV/um, logarithmic bins
+
+        // Resolved at the start of the run
+        const G4LogicalVolume* fLayerVolume;
+        std::vector<G4int> fStackSlots; // stack per physical volume instance ID, -1 if none
+        std::vector<G4String> fStackNames;
+        G4int fNLayers;
+        G4double fLogLETMin, fLETBinsPerDecade;
+
+        DenseAccumulator fCounts;       // [stack][layer][species]
+        DenseAccumulator fLET;          // [stack][layer][species][LET bin]
+};
+
+inline G4bool Cr39Scorer::IsEnabled() const { return fEnabled; }
+
+#endif
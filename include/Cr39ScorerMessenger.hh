@@ -0,0 +1,34 @@
+#ifndef CR39_SCORER_MESSENGER_H
+#define CR39_SCORER_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for Cr39ScorerMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class Cr39Scorer;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+
+class Cr39ScorerMessenger : public G4UImessenger {
+    public:
+        Cr39ScorerMessenger(Cr39Scorer*);
+        ~Cr39ScorerMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        Cr39Scorer*       fScorer;
+        G4UIdirectory*    fDirectory;
+        G4UIcmdWithABool* fScoreCmd;
+        G4UIcommand*      fLETBinsCmd;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef DENSE_ACCUMULATOR_H
+#define DENSE_ACCUMULATOR_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for DenseAccumulator class - a flat array of sums that every
+// thread fills without locking. Each thread adds its copy into the shared
+// total once, at the end of the run, and the master writes the total out.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+#include "G4Cache.hh"
+#include "ScoreFile.hh"
+
+class DenseAccumulator {
+    public:
+        DenseAccumulator();
+        ~DenseAccumulator();
+
+    public:
+        // Master thread, before the run: sets the size and clears the total
+        void Resize(std::size_t);
+        // Every thread, at the start and end of the run
+        void ResetLocal();
+        void Merge();
+
+        // This thread's array; fetch once and index it in hot loops
+        G4double* GetLocal() const;
+        void Add(std::size_t, G4double) const;
+
+        std::size_t GetSize() const;
+        const std::vector<G4double>& GetTotal() const;
+        // Master thread, after the merge
+        G4bool Write(const G4String&, const ScoreFileHeader&) const;
+
+    private:
+        std::size_t fSize;
+        G4Cache<std::vector<G4double> > fLocal;
+        std::vector<G4double> fTotal;
+};
+
+inline G4double* DenseAccumulator::GetLocal() const {
+    std::vector<G4double>& local = fLocal.Get();
+    if (local.size() != fSize) local.assign(fSize, 0.);
+    return local.data();
+}
+
+inline void DenseAccumulator::Add(std::size_t bin, G4double value) const {
+    GetLocal()[bin] += value;
+}
+
+inline std::size_t DenseAccumulator::GetSize() const { return fSize; }
+inline const std::vector<G4double>& DenseAccumulator::GetTotal() const { return fTotal; }
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef DEPOSIT_HIT_H
+#define DEPOSIT_HIT_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for DepositHit class - compact hit for the LANEX phosphor
+// and the converter of the gamma spectrometer, where only where and how
+// much energy was deposited matters. Single-precision position and energy, and no
+// vertex, total energy or creator process.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4ThreeVector.hh"
+#include "G4Allocator.hh"
+
+class DepositHit : public G4VHit {
+    public:
+        DepositHit();
+        ~DepositHit();
+
+        inline void* operator new(size_t);
+        inline void  operator delete(void*);
+
+    public:
+        G4double GetEdep() const;
+        G4ThreeVector GetPosition() const;
+        G4int GetParticleType() const;
+        G4int GetDetectorID() const;
+        G4int GetTrackID() const;
+        G4double GetWeight() const;
+        // Not kept; the values written in their place to the Hits tree
+        G4ThreeVector GetVertexPosition() const;
+        G4double GetEnergy() const;
+        G4int GetProcess() const;
+
+        void Set(G4int, G4int, G4int, const G4ThreeVector&, G4double, G4double);
+        // Adds a deposit of a track at a point, keeping the energy-weighted
+        // centroid; a hit collecting several tracks drops particle type and track ID
+        void Merge(G4int, const G4ThreeVector&, G4double);
+
+    private:
+        G4int fDetid;
+        G4int fParticleType;
+        G4int fTrackid;
+        G4float fX, fY, fZ;     // mm
+        G4float fEdep;          // MeV
+        G4float fWeight;
+};
+
+inline G4ThreeVector DepositHit::GetVertexPosition() const { return G4ThreeVector(); }
+inline G4double DepositHit::GetEnergy() const { return 0.; }
+inline G4int DepositHit::GetProcess() const { return -1; }
+
+typedef G4THitsCollection<DepositHit> DepositHitCollection;
+
+// Hits are freed with the event; the pool keeps their memory for the next one
+extern G4ThreadLocal G4Allocator<DepositHit>* DepositHitAllocator;
+
+inline void* DepositHit::operator new(size_t) {
+    if (!DepositHitAllocator) DepositHitAllocator = new G4Allocator<DepositHit>;
+    return (void*) DepositHitAllocator->MallocSingle();
+}
+
+inline void DepositHit::operator delete(void* hit) {
+    DepositHitAllocator->FreeSingle((DepositHit*) hit);
+}
+
+#endif
@@ -5,13 +5,18 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Header file for DetectorConstruction class
+// Last edited: 17/10/2026
 //
 
+#include <set>
+
 #include "G4VUserDetectorConstruction.hh"
+#include "G4ThreeVector.hh"
 
 class G4VPhysicalVolume;
 class G4LogicalVolume;
 class DetectorMessenger;
+class DetectorIDTable;
 
 class DetectorConstruction : public G4VUserDetectorConstruction {
     public:
@@ -25,13 +30,27 @@ class DetectorConstruction : public G4VUserDetectorConstruction {
         void DefineMaterials();
         G4VPhysicalVolume* DefineVolumes();
         virtual void SetMagnetStrength(G4double);
+        void SetHitDetectorID(const G4String&, G4int);
+        void SetTrackDetectorID(const G4String&, G4int);
+        const DetectorIDTable* GetDetectorIDTable() const;
+        void SetHitMode(G4int);
+        void SetVoxelSize(G4ThreeVector);
+        G4int GetHitMode() const;
+        G4ThreeVector GetVoxelSize() const;
+        // Boundary crossings of a sensitive detector, by name, go to the Bdx tree
+        void SetRecordCrossings(const G4String&, G4bool);
+        G4bool GetRecordCrossings(const G4String&) const;
 
     private:
         DetectorMessenger* fDetectorMessenger;
         G4LogicalVolume* fLogicChamberMagField;
         G4LogicalVolume* fLogicSpecMagField;
+        DetectorIDTable* fDetectorIDs;
 
         G4double fMagnetStrength;
+        G4int fHitMode;             // HitMode in SensitiveDetector.hh
+        G4ThreeVector fVoxelSize;
+        std::set<G4String> fNoCrossings;    // detectors recording no crossings
 
 };
 
@@ -0,0 +1,75 @@
+#ifndef DETECTOR_ID_TABLE_H
+#define DETECTOR_ID_TABLE_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for DetectorIDTable class - maps logical volumes to the base
+// detector IDs written with hits and tracks. Names are resolved once when
+// the geometry is built; lookups index a flat array by the volume's
+// instance ID. Also numbers the Cr-39 stacks, which share their logical
+// volume and copy number, by their physical volume.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <map>
+#include <vector>
+
+#include "globals.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+
+class DetectorIDTable {
+    public:
+        DetectorIDTable();
+        ~DetectorIDTable();
+
+    public:
+        // Master thread: configuration and resolution against the volume store
+        void SetHitID(const G4String&, G4int);
+        void SetTrackID(const G4String&, G4int);
+        void Build();
+        void Print() const;
+
+        // Base detector ID of a volume, or kNoDetector if it has none
+        G4int GetHitID(const G4LogicalVolume*) const;
+        G4int GetTrackID(const G4LogicalVolume*) const;
+        // Index of a placement of lStack, or kNoDetector
+        G4int GetStack(const G4VPhysicalVolume*) const;
+        G4int GetNumberOfStacks() const;
+        const G4String& GetStackName(G4int) const;
+
+        static const G4int kNoDetector = -1;
+
+    private:
+        void Resolve(const std::map<G4String, G4int>&, std::vector<G4int>&) const;
+
+    private:
+        std::map<G4String, G4int> fHitNames;
+        std::map<G4String, G4int> fTrackNames;
+        std::vector<G4int> fHitIDs;         // indexed by G4LogicalVolume instance ID
+        std::vector<G4int> fTrackIDs;
+        std::vector<G4int> fStacks;         // indexed by G4VPhysicalVolume instance ID
+        std::vector<G4String> fStackNames;
+};
+
+inline G4int DetectorIDTable::GetHitID(const G4LogicalVolume* volume) const {
+    std::size_t index = volume->GetInstanceID();
+    return (index < fHitIDs.size()) ? fHitIDs[index] : kNoDetector;
+}
+
+inline G4int DetectorIDTable::GetTrackID(const G4LogicalVolume* volume) const {
+    std::size_t index = volume->GetInstanceID();
+    return (index < fTrackIDs.size()) ? fTrackIDs[index] : kNoDetector;
+}
+
+inline G4int DetectorIDTable::GetStack(const G4VPhysicalVolume* volume) const {
+    std::size_t index = volume->GetInstanceID();
+    return (index < fStacks.size()) ? fStacks[index] : kNoDetector;
+}
+
+inline G4int DetectorIDTable::GetNumberOfStacks() const { return fStackNames.size(); }
+inline const G4String& DetectorIDTable::GetStackName(G4int stack) const { return fStackNames[stack]; }
+
+#endif
@@ -5,7 +5,7 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Header file for DetectorConstructionMessenger class
-// Last edited: 13/02/2022
+// Last edited: 17/10/2026
 
 #include "globals.hh"
 #include "G4UImessenger.hh"
@@ -13,6 +13,9 @@
 class DetectorConstruction;
 class G4UIdirectory;
 class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAString;
+class G4UIcmdWith3VectorAndUnit;
 
 class DetectorMessenger : public G4UImessenger {
     public:
@@ -27,6 +30,14 @@ class DetectorMessenger : public G4UImessenger {
         G4UIdirectory*        fSpecDir;
         G4UIcmdWithADoubleAndUnit* fMagnetStrengthCmd;
 
+        G4UIdirectory*        fDetDir;
+        G4UIcommand*          fHitIDCmd;
+        G4UIcommand*          fTrackIDCmd;
+        G4UIcmdWithoutParameter* fPrintIDsCmd;
+        G4UIcmdWithAString*   fHitModeCmd;
+        G4UIcmdWith3VectorAndUnit* fVoxelSizeCmd;
+        G4UIcommand*          fCrossingsCmd;
+
 
 };
 
@@ -0,0 +1,39 @@
+#ifndef DETECTOR_SD_H
+#define DETECTOR_SD_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for DetectorSD class template - sensitive detector keeping
+// one hit type. The YAG screens and Cr-39 layers keep Hit, with the
+// vertex and creator process needed to tell muons and their origin from
+// the background; the LANEX phosphor and the gamma spectrometer converter
+// keep the smaller DepositHit. Both are single precision. Instantiated for
+// Hit and DepositHit only.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+
+#include "SensitiveDetector.hh"
+
+template<class HitType>
+class DetectorSD : public SensitiveDetector {
+    public:
+        DetectorSD(G4String, const DetectorConstruction*, G4int);
+        ~DetectorSD();
+
+    protected:
+        virtual void InitializeHits(G4HCofThisEvent*, G4int);
+        virtual std::size_t AddHit(const G4Step*, G4int, const G4ThreeVector&, G4double, G4double);
+        virtual void MergeHit(std::size_t, G4int, const G4ThreeVector&, G4double);
+        virtual std::size_t FillHits(G4int);
+
+    private:
+        G4THitsCollection<HitType>* fHitCollection;
+};
+
+typedef DetectorSD<Hit> FullHitSD;
+typedef DetectorSD<DepositHit> DepositHitSD;
+
+#endif
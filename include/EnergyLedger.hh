@@ -0,0 +1,93 @@
+#ifndef ENERGY_LEDGER_H
+#define ENERGY_LEDGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for EnergyLedger class - energy budget of the geometry. For
+// every logical volume it sums the weighted energy deposited in it, the
+// kinetic energy carried out of the world from it and the kinetic energy
+// of tracks killed in it without interacting. Filled on every step, merged
+// over threads and written as a table at the end of the run.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "globals.hh"
+#include "RunScorer.hh"
+#include "DenseAccumulator.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+
+enum LedgerEntry {
+    kLedgerDeposited,
+    kLedgerEscaped,
+    kLedgerKilled,
+    kNLedgerEntries
+};
+
+class EnergyLedger : public RunScorer {
+    public:
+        static EnergyLedger* Instance();
+
+    public:
+        // Master thread
+        virtual void BeginOfRun();
+        virtual void Write(G4int) const;
+        // Every thread
+        virtual void ResetLocal();
+        virtual void Merge();
+        void Score(const G4Step*) const;
+        // Tracks killed by user actions, which the step itself does not show
+        void AddKilled(const G4Step*) const;
+
+        // Unweighted energy deposited in the current event on this thread
+        void ResetEvent() const;
+        G4double GetEventEdep() const;
+
+    private:
+        EnergyLedger();
+        ~EnergyLedger();
+
+    private:
+        DenseAccumulator fLedger;       // [logical volume instance ID][LedgerEntry]
+        static G4ThreadLocal G4double fEventEdep;
+};
+
+inline void EnergyLedger::Score(const G4Step* aStep) const {
+
+    const G4StepPoint* preStepPoint = aStep->GetPreStepPoint();
+    const G4StepPoint* postStepPoint = aStep->GetPostStepPoint();
+    G4double* ledger = fLedger.GetLocal()
+                       + kNLedgerEntries*preStepPoint->GetPhysicalVolume()->GetLogicalVolume()->GetInstanceID();
+    G4double weight = preStepPoint->GetWeight();
+
+    G4double edep = aStep->GetTotalEnergyDeposit();
+    if (edep != 0.) {
+        ledger[kLedgerDeposited] += weight*edep;
+        fEventEdep += edep;
+    }
+
+    if (postStepPoint->GetStepStatus() == fWorldBoundary) {
+        ledger[kLedgerEscaped] += weight*postStepPoint->GetKineticEnergy();
+    }
+    else if (aStep->GetTrack()->GetTrackStatus() == fStopAndKill && postStepPoint->GetKineticEnergy() > 0.) {
+        // Interactions hand the energy on to deposits and secondaries;
+        // transportation (loopers) and user limits simply drop it
+        const G4VProcess* process = postStepPoint->GetProcessDefinedStep();
+        G4ProcessType type = process ? process->GetProcessType() : fNotDefined;
+        if (type == fTransportation || type == fGeneral || type == fUserDefined) {
+            ledger[kLedgerKilled] += weight*postStepPoint->GetKineticEnergy();
+        }
+    }
+}
+
+inline void EnergyLedger::ResetEvent() const { fEventEdep = 0.; }
+inline G4double EnergyLedger::GetEventEdep() const { return fEventEdep; }
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef ENERGY_SAMPLER_H
+#define ENERGY_SAMPLER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+//
+// Header file for EnergySampler class - samples primary energies from a
+// tabulated spectrum using Walker's alias method. The spectrum is treated
+// as piecewise-linear between nodes, so each sample costs two uniform
+// numbers and no rejection loop.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+
+class EnergySampler {
+    public:
+        EnergySampler();
+        ~EnergySampler();
+
+    public:
+        // Tabulate f(E) on nbins+1 equally spaced nodes in [emin, emax]
+        template<typename F>
+        void BuildFromFunction(F f, G4double emin, G4double emax, G4int nbins);
+        // Two-column text file: energy (MeV) and relative intensity
+        G4bool BuildFromFile(const G4String&);
+
+        G4double Sample() const;
+        G4double Sample(G4double, G4double) const;
+
+        G4double GetEnergyMin() const;
+        G4double GetEnergyMax() const;
+        G4int GetNumberOfBins() const;
+
+    private:
+        G4bool Build(const std::vector<G4double>&, const std::vector<G4double>&);
+
+    private:
+        std::vector<G4double> fNodes;       // bin edges (energy)
+        std::vector<G4double> fDensity;     // spectrum value at each node
+        std::vector<G4double> fProb;        // alias acceptance probability per bin
+        std::vector<G4int>    fAlias;       // alias bin per bin
+};
+
+template<typename F>
+void EnergySampler::BuildFromFunction(F f, G4double emin, G4double emax, G4int nbins) {
+
+    std::vector<G4double> nodes(nbins + 1);
+    std::vector<G4double> density(nbins + 1);
+    for (G4int ii = 0; ii <= nbins; ++ii) {
+        nodes[ii] = emin + (emax - emin)*ii/nbins;
+        density[ii] = f(nodes[ii]);
+    }
+    Build(nodes, density);
+}
+
+#endif
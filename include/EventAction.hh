@@ -5,14 +5,35 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Header file for EventAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
+#include <vector>
+
 #include "G4UserEventAction.hh"
 #include "G4Event.hh"
 
 class RunAction;
 
+// Detectors and particle species of the per-event summary columns. The
+// detectors are the first summary groups; each Cr-39 stack follows with a
+// group of its own.
+enum SummaryDetector {
+    kSummaryYag,
+    kSummaryCr39,
+    kSummaryLanex,
+    kSummaryGSpec,
+    kNSummaryDetectors
+};
+
+enum SummarySpecies {
+    kSummaryMuon,
+    kSummaryElectron,       // electrons and positrons
+    kSummaryProton,
+    kSummaryOther,
+    kNSummarySpecies
+};
+
 class EventAction : public G4UserEventAction {
     public:
         EventAction(RunAction*);
@@ -21,11 +42,51 @@ class EventAction : public G4UserEventAction {
     public:
         virtual void BeginOfEventAction(const G4Event*);
         virtual void EndOfEventAction(const G4Event*);
-        void AddEdep(G4double);
-        G4double GetEdep() const;
+        void AddFlag(G4int);
+        // ID of the event being processed, read once at its start
+        G4int GetEventID() const;
+        // Called by the sensitive detectors for every energy-depositing step:
+        // summary group, species, track ID and energy deposit
+        void AddDeposit(G4int, G4int, G4int, G4double);
+
+        // Columns of the summary in the Events ntuple, created by RunAction
+        static void CreateSummaryColumns(G4int);
+        // Index of a named column of the Events ntuple, or -1
+        static G4int FindColumn(const G4String&);
+        // Prefix of a SummaryDetector in column names
+        static G4String GetDetectorName(G4int);
+        // Detectors plus Cr-39 stacks of the current geometry
+        static G4int GetNumberOfSummaryGroups();
+        static G4String GetSummaryGroupName(G4int);
 
     private:
-        G4double fEdep;
+        G4double GetColumnValue(G4int, G4double) const;
+
+    private:
+        RunAction* fRunAction;
+        G4int fEventID;
+        G4int fFlags;       // EventFlag bits, see SeedStore.hh
+
+        // Per-group summary: energy deposit, number of depositing steps and
+        // the number of distinct tracks of each species making them. A track
+        // is stepped to its end before the next starts, so it is new to a
+        // group whenever its ID differs from the last one seen there.
+        std::vector<G4double> fGroupEdep;
+        std::vector<G4int> fGroupSteps;
+        std::vector<G4int> fGroupLastTrack;
+        std::vector<G4int> fSpeciesTracks;      // [group][species]
+        std::vector<G4double> fTallyValues;
 };
 
+inline G4int EventAction::GetEventID() const { return fEventID; }
+
+inline void EventAction::AddDeposit(G4int group, G4int species, G4int trackID, G4double edep) {
+    fGroupEdep[group] += edep;
+    fGroupSteps[group] += 1;
+    if (fGroupLastTrack[group] != trackID) {
+        fGroupLastTrack[group] = trackID;
+        fSpeciesTracks[group*kNSummarySpecies + species] += 1;
+    }
+}
+
 #endif
\ No newline at end of file
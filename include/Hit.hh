@@ -4,18 +4,27 @@
 // GEANT4 simulation of the Apollon 2022 experiment.
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
-// Header file for Hit class
+// Header file for Hit class - hit for the YAG screens and the Cr-39
+// layers, keeping the vertex, total energy and creator process needed to
+// tell muons and their origin from the background. Stored in single
+// precision, in mm and MeV; float resolves well below a micron over the
+// few metres of the setup.
+// Last edited: 17/10/2026
 //
 
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
 #include "G4ThreeVector.hh"
+#include "G4Allocator.hh"
 
 class Hit : public G4VHit {
     public:
         Hit();
         ~Hit();
 
+        inline void* operator new(size_t);
+        inline void  operator delete(void*);
+
     public:
         G4double GetEdep() const;
         G4double GetEnergy() const;
@@ -25,6 +34,7 @@ class Hit : public G4VHit {
         G4int GetProcess() const;
         G4int GetDetectorID() const;
         G4int GetTrackID() const;
+        G4double GetWeight() const;
 
         void AddEdep(G4double);
         void AddEnergy(G4double);
@@ -34,19 +44,37 @@ class Hit : public G4VHit {
         void AddProcess(G4int);
         void AddDetectorID(G4int);
         void AddTrackID(G4int);
+        void AddWeight(G4double);
+        // Adds a deposit of a track at a point, keeping the energy-weighted
+        // centroid; a hit collecting several tracks drops the track's
+        // particle type, track ID, vertex, process and energy
+        void Merge(G4int, G4ThreeVector, G4double);
 
     private:
-        G4double fEdep;
-        G4double fEnergy;
-        G4ThreeVector fPosition;
-        G4ThreeVector fVertexPosition;
         G4int fParticleType;
         G4int fProcess;
         G4int fDetid;
         G4int fTrackid;
+        G4float fX, fY, fZ;             // mm
+        G4float fVtxX, fVtxY, fVtxZ;    // mm
+        G4float fEdep;                  // MeV
+        G4float fEnergy;                // MeV
+        G4float fWeight;
 
 };
 
 typedef G4THitsCollection<Hit> HitCollection;
 
+// Hits are freed with the event; the pool keeps their memory for the next one
+extern G4ThreadLocal G4Allocator<Hit>* HitAllocator;
+
+inline void* Hit::operator new(size_t) {
+    if (!HitAllocator) HitAllocator = new G4Allocator<Hit>;
+    return (void*) HitAllocator->MallocSingle();
+}
+
+inline void Hit::operator delete(void* hit) {
+    HitAllocator->FreeSingle((Hit*) hit);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef MUON_TRUTH_MESSENGER_H
+#define MUON_TRUTH_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for MuonTruthMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class MuonTruthStore;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class MuonTruthMessenger : public G4UImessenger {
+    public:
+        MuonTruthMessenger(MuonTruthStore*);
+        ~MuonTruthMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        MuonTruthStore*            fStore;
+        G4UIdirectory*             fDirectory;
+        G4UIcmdWithABool*          fTruthCmd;
+        G4UIcmdWithADoubleAndUnit* fPlaneCmd;
+        G4UIcmdWithoutParameter*   fClearPlanesCmd;
+};
+
+#endif
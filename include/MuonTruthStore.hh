@@ -0,0 +1,52 @@
+#ifndef MUON_TRUTH_STORE_H
+#define MUON_TRUTH_STORE_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for MuonTruthStore class - production history of muons.
+// Every track of the event is entered in a compact table indexed by track
+// ID; at the end of the event only the muons and their ancestors are
+// written, together with the points where the muons crossed the
+// configured z planes. The table is then cleared for the next event.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+
+class MuonTruthMessenger;
+class G4Track;
+class G4Step;
+
+class MuonTruthStore {
+    public:
+        static MuonTruthStore* Instance();
+
+    public:
+        // Worker threads, during the event
+        void BeginEvent() const;
+        void AddTrack(const G4Track*) const;
+        void Score(const G4Step*) const;
+        void EndEvent(G4int) const;
+
+        G4bool IsEnabled() const;
+        void SetEnabled(G4bool);
+        void AddPlane(G4double);
+        void ClearPlanes();
+
+    private:
+        MuonTruthStore();
+        ~MuonTruthStore();
+
+    private:
+        MuonTruthMessenger* fMessenger;
+        G4bool fEnabled;
+        std::vector<G4double> fPlanes;      // z positions of the crossing planes
+};
+
+inline G4bool MuonTruthStore::IsEnabled() const { return fEnabled; }
+
+#endif
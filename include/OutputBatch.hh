@@ -0,0 +1,178 @@
+#ifndef OUTPUT_BATCH_H
+#define OUTPUT_BATCH_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for OutputBatch class - the ntuple rows of one event, kept
+// as a packed list of column fills. Filled by the worker during the event
+// and replayed into the analysis manager by a writer thread. Without a
+// writer thread the fills go straight to the analysis manager instead,
+// or are dropped when the thread has no file open.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstdint>
+#include <vector>
+
+#include "globals.hh"
+#include "G4VAnalysisManager.hh"
+
+class ColumnFormatTable;
+class VectorColumns;
+
+class OutputBatch {
+    public:
+        OutputBatch();
+        ~OutputBatch();
+
+    public:
+        // Same arguments as the analysis manager calls they stand for
+        void FillNtupleIColumn(G4int, G4int, G4int);
+        void FillNtupleDColumn(G4int, G4int, G4double);
+        void FillNtupleSColumn(G4int, G4int, const G4String&);
+        void AddNtupleRow(G4int);
+        // Values of a vector column, appended to in place; they are handed
+        // to the bound vectors of the column when the row is added
+        std::vector<G4int>& GetNtupleIVector(G4int, G4int);
+        std::vector<G4double>& GetNtupleDVector(G4int, G4int);
+        const std::vector<G4int>* FindNtupleIVector(G4int, G4int) const;
+        const std::vector<G4double>* FindNtupleDVector(G4int, G4int) const;
+
+        // Fills are recorded by default; they can instead be passed on to
+        // the analysis manager as they come, or dropped
+        void PassFills(G4VAnalysisManager*, const ColumnFormatTable*, VectorColumns*);
+        void DropFills();
+
+        // Real values are converted to the storage format of their column
+        void Replay(G4VAnalysisManager*, const ColumnFormatTable&, VectorColumns*) const;
+        void Clear();
+        G4bool IsEmpty() const;
+        // Event the rows belong to, which orders batches in a merged file
+        void SetEventID(G4int);
+        G4int GetEventID() const;
+
+    private:
+        enum FillMode {
+            kRecord,
+            kPass,
+            kDrop
+        };
+
+        void PassDouble(G4int, G4int, G4double) const;
+        void PassRow(G4int);
+        static void FillDouble(G4VAnalysisManager*, const ColumnFormatTable&, G4int, G4int, G4double);
+
+    private:
+        enum OpType {
+            kFillInt,
+            kFillDouble,
+            kFillString,        // value is an index into fStrings
+            kAddRow
+        };
+
+        struct Op {
+            int16_t  type;
+            int16_t  ntuple;
+            int32_t  column;
+            union {
+                G4int    ival;
+                G4double dval;
+            };
+        };
+
+        std::vector<Op> fOps;
+        std::vector<G4String> fStrings;
+        std::vector<std::vector<std::vector<G4int> > > fIVectors;       // [ntuple][column]
+        std::vector<std::vector<std::vector<G4double> > > fDVectors;
+        G4int fEventID;
+
+        G4int fMode;                                // FillMode
+        G4VAnalysisManager* fAnalysisManager;       // when passing fills on
+        const ColumnFormatTable* fFormats;
+        VectorColumns* fVectors;
+};
+
+inline void OutputBatch::FillNtupleIColumn(G4int ntuple, G4int column, G4int value) {
+    if (fMode != kRecord) {
+        if (fMode == kPass) fAnalysisManager->FillNtupleIColumn(ntuple, column, value);
+        return;
+    }
+    Op op;
+    op.type = kFillInt;
+    op.ntuple = ntuple;
+    op.column = column;
+    op.ival = value;
+    fOps.push_back(op);
+}
+
+inline void OutputBatch::FillNtupleDColumn(G4int ntuple, G4int column, G4double value) {
+    if (fMode != kRecord) {
+        if (fMode == kPass) PassDouble(ntuple, column, value);
+        return;
+    }
+    Op op;
+    op.type = kFillDouble;
+    op.ntuple = ntuple;
+    op.column = column;
+    op.dval = value;
+    fOps.push_back(op);
+}
+
+inline void OutputBatch::FillNtupleSColumn(G4int ntuple, G4int column, const G4String& value) {
+    if (fMode != kRecord) {
+        if (fMode == kPass) fAnalysisManager->FillNtupleSColumn(ntuple, column, value);
+        return;
+    }
+    Op op;
+    op.type = kFillString;
+    op.ntuple = ntuple;
+    op.column = column;
+    op.ival = fStrings.size();
+    fOps.push_back(op);
+    fStrings.push_back(value);
+}
+
+inline void OutputBatch::AddNtupleRow(G4int ntuple) {
+    if (fMode != kRecord) {
+        if (fMode == kPass) PassRow(ntuple);
+        return;
+    }
+    Op op;
+    op.type = kAddRow;
+    op.ntuple = ntuple;
+    op.column = -1;
+    op.ival = 0;
+    fOps.push_back(op);
+}
+
+inline std::vector<G4int>& OutputBatch::GetNtupleIVector(G4int ntuple, G4int column) {
+    if (ntuple >= static_cast<G4int>(fIVectors.size())) fIVectors.resize(ntuple + 1);
+    if (column >= static_cast<G4int>(fIVectors[ntuple].size())) fIVectors[ntuple].resize(column + 1);
+    return fIVectors[ntuple][column];
+}
+
+inline std::vector<G4double>& OutputBatch::GetNtupleDVector(G4int ntuple, G4int column) {
+    if (ntuple >= static_cast<G4int>(fDVectors.size())) fDVectors.resize(ntuple + 1);
+    if (column >= static_cast<G4int>(fDVectors[ntuple].size())) fDVectors[ntuple].resize(column + 1);
+    return fDVectors[ntuple][column];
+}
+
+inline const std::vector<G4int>* OutputBatch::FindNtupleIVector(G4int ntuple, G4int column) const {
+    if (ntuple >= static_cast<G4int>(fIVectors.size())) return 0;
+    if (column >= static_cast<G4int>(fIVectors[ntuple].size())) return 0;
+    return &fIVectors[ntuple][column];
+}
+
+inline const std::vector<G4double>* OutputBatch::FindNtupleDVector(G4int ntuple, G4int column) const {
+    if (ntuple >= static_cast<G4int>(fDVectors.size())) return 0;
+    if (column >= static_cast<G4int>(fDVectors[ntuple].size())) return 0;
+    return &fDVectors[ntuple][column];
+}
+
+inline G4bool OutputBatch::IsEmpty() const { return fOps.empty(); }
+inline void OutputBatch::SetEventID(G4int evid) { fEventID = evid; }
+inline G4int OutputBatch::GetEventID() const { return fEventID; }
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef OUTPUT_MANAGER_H
+#define OUTPUT_MANAGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for OutputManager class - output stage between the user
+// actions and the analysis manager. Chooses the output format and file
+// name of each run. Ntuple rows of an event are collected in an
+// OutputBatch; at the end of the event the batch is either replayed
+// straight away or pushed onto a lock-free queue drained by a writer
+// thread, which then does the ntuple filling and basket compression.
+// In merged mode the workers' queues all go to one writer thread of the
+// master, which writes a single file in event order. In the event
+// layout the hits, tracks and crossings of an event go to vector columns
+// of a single row.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <map>
+#include <vector>
+
+#include "globals.hh"
+#include "ColumnFormat.hh"
+
+class OutputBatch;
+class OutputMessenger;
+class G4VAnalysisManager;
+
+class OutputManager {
+    public:
+        static OutputManager* Instance();
+
+    public:
+        // Every thread: the file is opened before the ntuples are booked,
+        // the writer started once they are, and the file written at the end
+        void OpenFile(G4int);
+        void BeginOfRun();
+        void EndOfRun();
+        // Analysis manager of the selected format on this thread
+        G4VAnalysisManager* GetAnalysisManager() const;
+        G4bool IsWriting() const;
+        // Real column stored as set with /output/precision; the storage of
+        // every such column goes to the Formats ntuple for the readers
+        G4int CreateNtupleRealColumn(G4int, const G4String&, const G4String&);
+        // Vector columns of the event layout, bound to vectors of this
+        // thread; a real one is stored as the named flat column would be
+        G4int CreateNtupleIVectorColumn(G4int, const G4String&);
+        G4int CreateNtupleRealVectorColumn(G4int, const G4String&, const G4String&, const G4String&);
+        void FillColumnFormats(G4int) const;
+        // Names of the other output files of the run, set by the master in
+        // OpenFile: a template expanded like the ntuple file name, or a
+        // file named after the ntuple file, e.g. apollon_out_run0_<name>
+        G4String ExpandFileName(const G4String&) const;
+        G4String GetRunFileName(const G4String&) const;
+        const ColumnFormatTable& GetColumnFormats() const;
+        // Batch collecting the rows of the current event on this thread
+        OutputBatch* GetBatch() const;
+        // Hands the batch over to the writer; called last in the event
+        void EndEvent(G4int) const;
+
+        G4bool IsAsync() const;
+        G4bool IsEventLayout() const;
+        void SetAsync(G4bool);
+        void SetMerge(G4bool);
+        void SetQueueDepth(G4int);
+        void SetBackend(const G4String&);
+        void SetFileName(const G4String&);
+        void SetParameter(const G4String&, const G4String&);
+        void ClearParameters();
+        void SetBasketSize(G4int);
+        void SetCompressionLevel(G4int);
+        void SetPrecision(const G4String&, const G4String&, const G4String&, G4double);
+        void SetLayout(const G4String&);
+
+    private:
+        struct BookedFormat {
+            G4String ntuple;
+            G4String column;
+            ColumnFormat format;
+        };
+
+    private:
+        OutputManager();
+        ~OutputManager();
+        ColumnFormat FindPrecision(const G4String&, const G4String&) const;
+        void RecordFormat(const G4String&, const G4String&, const ColumnFormat&);
+
+    private:
+        OutputMessenger* fMessenger;
+        G4bool fAsync;
+        G4int fQueueDepth;      // events a worker may run ahead of its writer
+        G4bool fMerge;
+
+        G4String fBackend;      // root, hdf5, csv or none
+        G4String fFileName;     // template, without extension
+        std::map<G4String, G4String> fParameters;
+        G4int fRunID;           // run being written
+        G4String fRunFileName;  // expanded by the master, opened by every thread
+        G4int fBasketSize;      // bytes; ROOT basket or HDF5 chunk
+        G4int fCompression;
+        G4bool fEventLayout;    // one row per event in HitEvents, TrackEvents and BdxEvents
+
+        std::map<G4String, ColumnFormat> fPrecision;    // by ntuple/column name
+        ColumnFormatTable fColumnFormats;               // columns booked for this run
+        std::vector<BookedFormat> fBookedFormats;
+};
+
+inline G4bool OutputManager::IsAsync() const { return fAsync; }
+inline G4bool OutputManager::IsEventLayout() const { return fEventLayout; }
+inline G4bool OutputManager::IsWriting() const { return fBackend != "none"; }
+inline const ColumnFormatTable& OutputManager::GetColumnFormats() const { return fColumnFormats; }
+
+#endif
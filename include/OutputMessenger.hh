@@ -0,0 +1,46 @@
+#ifndef OUTPUT_MESSENGER_H
+#define OUTPUT_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for OutputMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class OutputManager;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+class OutputMessenger : public G4UImessenger {
+    public:
+        OutputMessenger(OutputManager*);
+        ~OutputMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        OutputManager*        fManager;
+        G4UIdirectory*        fDirectory;
+        G4UIcmdWithABool*     fAsyncCmd;
+        G4UIcmdWithAnInteger* fQueueDepthCmd;
+        G4UIcmdWithABool*     fMergeCmd;
+        G4UIcmdWithAString*   fBackendCmd;
+        G4UIcmdWithAString*   fFileNameCmd;
+        G4UIcommand*          fParameterCmd;
+        G4UIcmdWithoutParameter* fClearParametersCmd;
+        G4UIcmdWithAnInteger* fBasketSizeCmd;
+        G4UIcmdWithAnInteger* fCompressionCmd;
+        G4UIcommand*          fPrecisionCmd;
+        G4UIcmdWithAString*   fLayoutCmd;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef PHASE_SPACE_MESSENGER_H
+#define PHASE_SPACE_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for PhaseSpaceMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class PhaseSpaceWriter;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+
+class PhaseSpaceMessenger : public G4UImessenger {
+    public:
+        PhaseSpaceMessenger(PhaseSpaceWriter*);
+        ~PhaseSpaceMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        PhaseSpaceWriter*          fWriter;
+        G4UIdirectory*             fDirectory;
+        G4UIcmdWithABool*          fRecordCmd;
+        G4UIcmdWithAString*        fFileNameCmd;
+        G4UIcmdWithADoubleAndUnit* fPlaneZCmd;
+        G4UIcmdWithABool*          fKillCmd;
+};
+
+#endif
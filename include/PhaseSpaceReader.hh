@@ -0,0 +1,56 @@
+#ifndef PHASE_SPACE_READER_H
+#define PHASE_SPACE_READER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for PhaseSpaceReader class - read-only memory map of a
+// phase-space file shared by all worker threads. Threads claim records
+// through an atomic cursor, so reading takes no lock and copies nothing.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <atomic>
+#include <cstddef>
+
+#include "globals.hh"
+#include "PhaseSpaceRecord.hh"
+
+class PhaseSpaceReader {
+    public:
+        // Shared instance, mapped or not
+        static PhaseSpaceReader* Instance();
+        // Shared instance; maps the file on first use or when the name changes
+        static PhaseSpaceReader* Open(const G4String&);
+
+    public:
+        // First of n consecutive records claimed by the caller
+        uint64_t Claim(uint64_t n = 1);
+        const PhaseSpaceRecord& GetRecord(uint64_t) const;
+
+        uint64_t GetNumberOfRecords() const;
+        const G4String& GetFileName() const;
+        // Back to the first record; called at the start of every run
+        void Rewind();
+
+    private:
+        PhaseSpaceReader();
+        ~PhaseSpaceReader();
+        G4bool Map(const G4String&);
+        void Unmap();
+
+    private:
+        G4String fFileName;
+        void* fMapping;
+        std::size_t fMappingSize;
+        const PhaseSpaceRecord* fRecords;
+        uint64_t fNRecords;
+        std::atomic<uint64_t> fCursor;
+        std::atomic<G4bool> fWrapped;
+};
+
+inline uint64_t PhaseSpaceReader::GetNumberOfRecords() const { return fNRecords; }
+inline const G4String& PhaseSpaceReader::GetFileName() const { return fFileName; }
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef PHASE_SPACE_RECORD_H
+#define PHASE_SPACE_RECORD_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Binary layout of phase-space files. A file is a PhaseSpaceHeader followed
+// by nRecords fixed-size PhaseSpaceRecords, little-endian, no padding.
+// Positions are in mm, momenta in MeV/c and kinetic energy in MeV.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstdint>
+
+struct PhaseSpaceHeader {
+    char     magic[8];      // "APOLPS1" + '\0'
+    uint32_t version;
+    uint32_t recordSize;    // sizeof(PhaseSpaceRecord)
+    uint64_t nRecords;
+    uint64_t reserved;
+};
+
+struct PhaseSpaceRecord {
+    int32_t pdg;
+    float   x, y, z;
+    float   px, py, pz;
+    float   energy;
+    float   weight;
+};
+
+static_assert(sizeof(PhaseSpaceHeader) == 32, "PhaseSpaceHeader must be 32 bytes");
+static_assert(sizeof(PhaseSpaceRecord) == 36, "PhaseSpaceRecord must be 36 bytes");
+
+static const char     kPhaseSpaceMagic[8] = {'A', 'P', 'O', 'L', 'P', 'S', '1', '\0'};
+static const uint32_t kPhaseSpaceVersion  = 1;
+
+#endif
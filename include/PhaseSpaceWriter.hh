@@ -0,0 +1,69 @@
+#ifndef PHASE_SPACE_WRITER_H
+#define PHASE_SPACE_WRITER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for PhaseSpaceWriter class - records every particle crossing
+// a plane of constant z in the +z direction to a phase-space file that can
+// be read back by the phasespace primary source. Each thread fills its own
+// buffer; full buffers are appended to the single output file under a lock.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstdio>
+#include <vector>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "PhaseSpaceRecord.hh"
+
+class PhaseSpaceMessenger;
+class G4Step;
+
+class PhaseSpaceWriter {
+    public:
+        static PhaseSpaceWriter* Instance();
+
+    public:
+        // Master thread, start and end of run
+        void Open();
+        void Close();
+        // Any thread
+        G4bool IsForwardCrossing(const G4Step*) const;
+        void Record(const G4Step*);
+        void Flush();
+
+        G4bool IsRecording() const;
+        G4double GetPlaneZ() const;
+        G4bool GetKillAtPlane() const;
+
+        void SetRecording(G4bool);
+        void SetFileName(const G4String&);
+        void SetPlaneZ(G4double);
+        void SetKillAtPlane(G4bool);
+
+    private:
+        PhaseSpaceWriter();
+        ~PhaseSpaceWriter();
+        void WriteHeader();
+
+    private:
+        PhaseSpaceMessenger* fMessenger;
+        G4bool fEnabled;
+        G4String fFileName;     // template, expanded like the ntuple file name
+        G4String fRunFileName;
+        G4double fPlaneZ;
+        G4bool fKillAtPlane;
+
+        std::FILE* fFile;
+        uint64_t fNRecords;
+        std::vector<std::vector<PhaseSpaceRecord>*> fBuffers;  // of every thread, freed with the writer
+};
+
+inline G4bool PhaseSpaceWriter::IsRecording() const { return fFile != 0; }
+inline G4double PhaseSpaceWriter::GetPlaneZ() const { return fPlaneZ; }
+inline G4bool PhaseSpaceWriter::GetKillAtPlane() const { return fKillAtPlane; }
+
+#endif
@@ -4,16 +4,23 @@
 //
 // GEANT4 simulation of the Apollon 2022 experiment.
 // Geometry has been derived from the FLUKA simulation of the same experiment.
-// 
+//
 // Header file for PrimaryGeneratorAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
+#include <vector>
+
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4Types.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
 
-class G4ParticleGun;
 class G4Event;
+class G4ParticleDefinition;
+class EnergySampler;
+class PhaseSpaceReader;
+class PrimaryGeneratorMessenger;
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction {
     public:
@@ -23,10 +30,39 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction {
     public:
         virtual void GeneratePrimaries(G4Event*);
         G4double SampleEnergyValue();
+        void SetSpectrum(const G4String&);
+        void SetSource(const G4String&);
+        void SetPhaseSpaceFile(const G4String&);
+        void SetBunchSize(G4int);
+        void SetGunWeight(G4double);
 
     private:
-        G4ParticleGun* fParticleGun;
+        void SampleGunBunch(G4Event*);
+        // Number of primaries read, fewer if the event was aborted or records were skipped
+        G4int ReadPhaseSpaceBunch(G4Event*);
+        void AddPrimary(G4Event*, const G4ParticleDefinition*, const G4ThreeVector&, G4double, const G4ThreeVector&,
+                        G4double);
+        void FillPrimaryNtuple(G4int, G4int);
+        void BuildDefaultSpectrum();
+
+    private:
+        G4ParticleDefinition* fElectron;
+        EnergySampler* fEnergySampler;
+        PhaseSpaceReader* fPhaseSpaceReader;    // null when using the particle gun
+        G4String fPhaseSpaceFile;
+        G4int fPhaseSpacePDG;
+        G4ParticleDefinition* fPhaseSpaceParticle;
+        G4int fBunchSize;
+        G4double fGunWeight;
+        PrimaryGeneratorMessenger* fMessenger;
+
+        // Per-bunch work arrays, reused between events
+        std::vector<G4double> fUniforms;
+        std::vector<G4double> fX, fY, fZ;
+        std::vector<G4double> fEnergy;
+        std::vector<G4double> fTheta, fPhi;
+        std::vector<G4double> fWeight;
 
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,38 @@
+#ifndef PRIMARY_GENERATOR_MESSENGER_H
+#define PRIMARY_GENERATOR_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for PrimaryGeneratorMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+
+class PrimaryGeneratorMessenger : public G4UImessenger {
+    public:
+        PrimaryGeneratorMessenger(PrimaryGeneratorAction*);
+        ~PrimaryGeneratorMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        PrimaryGeneratorAction* fPrimaryGenerator;
+        G4UIdirectory*          fBeamDir;
+        G4UIcmdWithAString*     fSpectrumCmd;
+        G4UIcmdWithAString*     fSourceCmd;
+        G4UIcmdWithAString*     fPhaseSpaceFileCmd;
+        G4UIcmdWithAnInteger*   fBunchSizeCmd;
+        G4UIcmdWithADouble*     fWeightCmd;
+};
+
+#endif
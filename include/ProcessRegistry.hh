@@ -0,0 +1,53 @@
+#ifndef PROCESS_REGISTRY_H
+#define PROCESS_REGISTRY_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ProcessRegistry class - assigns every process a stable
+// integer ID, 1000*type + subtype (0 for primaries), used for the procid
+// column of all ntuples. The ID is computed from the process on every
+// call; the registry only keeps the ID legend, built by each thread from
+// its own processes at the start of a run.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <set>
+#include <utility>
+
+#include "globals.hh"
+#include "G4VProcess.hh"
+#include "G4Track.hh"
+
+class ProcessRegistry {
+    public:
+        static ProcessRegistry* Instance();
+
+    public:
+        void Build();
+        void Fill(G4int) const;     // writes the ID legend to an ntuple
+
+        static G4int GetID(const G4VProcess*);
+        static G4int GetCreatorID(const G4Track*);
+
+    private:
+        ProcessRegistry();
+        ~ProcessRegistry();
+
+    private:
+        // Processes of the same type and subtype share an ID (e.g. eIoni
+        // and muIoni), so the legend has one entry per distinct (ID, name)
+        std::set<std::pair<G4int, G4String> > fLegend;
+};
+
+inline G4int ProcessRegistry::GetID(const G4VProcess* process) {
+    if (!process) return 0;
+    return 1000*process->GetProcessType() + process->GetProcessSubType();
+}
+
+inline G4int ProcessRegistry::GetCreatorID(const G4Track* track) {
+    return GetID(track->GetCreatorProcess());
+}
+
+#endif
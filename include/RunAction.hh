@@ -5,11 +5,16 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Header file for RunAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
+#include <vector>
+
 #include "G4UserRunAction.hh"
 
+#include "TallyAccumulable.hh"
+
 class G4Run;
+class RunScorer;
 
 class RunAction : public G4UserRunAction {
     public:
@@ -19,7 +24,13 @@ class RunAction : public G4UserRunAction {
     public:
         virtual void BeginOfRunAction(const G4Run*);
         virtual void EndOfRunAction(const G4Run*);
+        TallyAccumulable& GetTallies();
 
+    private:
+        TallyAccumulable fTallies;      // convergence tallies of this thread
+        std::vector<RunScorer*> fScorers;   // singletons, in the order they are written
 };
 
+inline TallyAccumulable& RunAction::GetTallies() { return fTallies; }
+
 #endif
\ No newline at end of file
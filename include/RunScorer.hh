@@ -0,0 +1,31 @@
+#ifndef RUN_SCORER_H
+#define RUN_SCORER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for RunScorer class - interface of the scorers driven through
+// the run by RunAction: each thread scores into its own local copy, which
+// is added to the shared totals at the end of the run and written by the
+// master.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "globals.hh"
+
+class RunScorer {
+    public:
+        virtual ~RunScorer() {}
+
+    public:
+        // Master thread, before the workers start the run
+        virtual void BeginOfRun() = 0;
+        // Master thread, once every thread has merged
+        virtual void Write(G4int) const = 0;
+        // Every thread
+        virtual void ResetLocal() = 0;
+        virtual void Merge() = 0;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SCORE_FILE_H
+#define SCORE_FILE_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Binary layout of score files written at the end of a run by the online
+// scorers. A file is a ScoreFileHeader followed by the product of shape[]
+// doubles in C order (last dimension fastest), little-endian, no padding.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstdint>
+
+struct ScoreFileHeader {
+    char     magic[8];      // "APOLSC1" + '\0'
+    uint32_t version;
+    uint32_t rank;          // number of dimensions in use (at most 4)
+    uint32_t shape[4];      // bins per dimension
+    uint32_t logAxes;       // bit i set: dimension i has logarithmic bins
+    uint32_t reserved;
+    double   lower[4];      // lower edge of each dimension
+    double   upper[4];      // upper edge of each dimension
+    uint64_t nEvents;       // events in the run
+    char     quantity[16];  // name of the scored quantity, '\0'-padded
+    char     unit[16];      // its unit
+};
+
+static_assert(sizeof(ScoreFileHeader) == 144, "ScoreFileHeader must be 144 bytes");
+
+static const char     kScoreFileMagic[8] = {'A', 'P', 'O', 'L', 'S', 'C', '1', '\0'};
+static const uint32_t kScoreFileVersion  = 1;
+
+#endif
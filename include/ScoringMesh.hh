@@ -0,0 +1,76 @@
+#ifndef SCORING_MESH_H
+#define SCORING_MESH_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ScoringMesh class - an axis-aligned box of voxels in the
+// world frame scoring energy deposit, dose or track-length fluence,
+// optionally restricted to one particle type and one logical volume.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "DenseAccumulator.hh"
+
+class G4Step;
+class G4ParticleDefinition;
+class G4LogicalVolume;
+
+enum MeshQuantity {
+    kMeshEdep,          // MeV
+    kMeshDose,          // Gy
+    kMeshFluence        // 1/cm2, from track length per voxel volume
+};
+
+class ScoringMesh {
+    public:
+        ScoringMesh(const G4String&);
+        ~ScoringMesh();
+
+    public:
+        // Master thread, at the start and end of the run
+        void BeginOfRun();
+        void Write(G4int) const;
+        // Every thread
+        void ResetLocal();
+        void Merge();
+        void Score(const G4Step*) const;
+
+        void SetHalfSize(G4ThreeVector);
+        void SetCentre(G4ThreeVector);
+        void SetBins(G4int, G4int, G4int);
+        void SetQuantity(const G4String&);
+        void SetParticle(const G4String&);
+        void SetVolume(const G4String&);
+
+        const G4String& GetName() const;
+        void Print() const;
+
+    private:
+        void ScoreTrackLength(const G4Step*, G4double) const;
+
+    private:
+        G4String fName;
+        G4ThreeVector fCentre;
+        G4ThreeVector fHalfSize;
+        G4int fBins[3];
+        G4int fQuantity;
+        G4String fParticleName;         // "all" for no filter
+        G4String fVolumeName;           // "all" for no filter
+
+        // Resolved at the start of the run
+        G4ThreeVector fLower;
+        G4ThreeVector fVoxelSize;
+        G4double fScale;                // per-step value to output units
+        const G4ParticleDefinition* fParticle;
+        const G4LogicalVolume* fVolume;
+
+        DenseAccumulator fScores;
+};
+
+inline const G4String& ScoringMesh::GetName() const { return fName; }
+
+#endif
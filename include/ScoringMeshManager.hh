@@ -0,0 +1,51 @@
+#ifndef SCORING_MESH_MANAGER_H
+#define SCORING_MESH_MANAGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ScoringMeshManager class - owns the scoring meshes
+// defined from macros and drives them through the run.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+#include "RunScorer.hh"
+
+class ScoringMesh;
+class ScoringMeshMessenger;
+class G4Step;
+
+class ScoringMeshManager : public RunScorer {
+    public:
+        static ScoringMeshManager* Instance();
+
+    public:
+        // Master thread
+        ScoringMesh* CreateMesh(const G4String&);
+        ScoringMesh* GetCurrentMesh() const;
+        virtual void BeginOfRun();
+        virtual void Write(G4int) const;
+        void List() const;
+        // Every thread
+        virtual void ResetLocal();
+        virtual void Merge();
+        void Score(const G4Step*) const;
+
+        G4bool HasMeshes() const;
+
+    private:
+        ScoringMeshManager();
+        ~ScoringMeshManager();
+
+    private:
+        ScoringMeshMessenger* fMessenger;
+        std::vector<ScoringMesh*> fMeshes;
+};
+
+inline G4bool ScoringMeshManager::HasMeshes() const { return !fMeshes.empty(); }
+
+#endif
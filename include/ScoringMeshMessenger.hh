@@ -0,0 +1,42 @@
+#ifndef SCORING_MESH_MESSENGER_H
+#define SCORING_MESH_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ScoringMeshMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class ScoringMeshManager;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWith3VectorAndUnit;
+class G4UIcmdWithoutParameter;
+
+class ScoringMeshMessenger : public G4UImessenger {
+    public:
+        ScoringMeshMessenger(ScoringMeshManager*);
+        ~ScoringMeshMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        ScoringMeshManager*        fManager;
+        G4UIdirectory*             fDirectory;
+        G4UIcmdWithAString*        fCreateCmd;
+        G4UIcmdWith3VectorAndUnit* fSizeCmd;
+        G4UIcmdWith3VectorAndUnit* fPositionCmd;
+        G4UIcommand*               fBinsCmd;
+        G4UIcmdWithAString*        fQuantityCmd;
+        G4UIcmdWithAString*        fParticleCmd;
+        G4UIcmdWithAString*        fVolumeCmd;
+        G4UIcmdWithoutParameter*   fListCmd;
+};
+
+#endif
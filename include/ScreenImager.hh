@@ -0,0 +1,64 @@
+#ifndef SCREEN_IMAGER_H
+#define SCREEN_IMAGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ScreenImager class - accumulates an energy-deposit image
+// of each placement of the imaged screen volumes, in the screen's own x-y
+// frame. One image file per screen is written at the end of the run.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <map>
+#include <vector>
+
+#include "globals.hh"
+#include "RunScorer.hh"
+#include "DenseAccumulator.hh"
+
+class ScreenImagerMessenger;
+class G4Step;
+class G4VPhysicalVolume;
+
+class ScreenImager : public RunScorer {
+    public:
+        static ScreenImager* Instance();
+
+    public:
+        // Master thread
+        virtual void BeginOfRun();
+        virtual void Write(G4int) const;
+        // Every thread
+        virtual void ResetLocal();
+        virtual void Merge();
+        void Score(const G4Step*) const;
+
+        G4bool IsEnabled() const;
+        void SetEnabled(G4bool);
+        void SetPixels(const G4String&, G4int, G4int);
+
+    private:
+        ScreenImager();
+        ~ScreenImager();
+        void ClearScreens();
+
+    private:
+        struct Screen {
+            G4String name;              // physical volume name
+            G4int nx, ny;
+            G4double halfX, halfY;
+            DenseAccumulator image;     // ny rows of nx pixels
+        };
+
+        ScreenImagerMessenger* fMessenger;
+        G4bool fEnabled;
+        std::map<G4String, std::pair<G4int, G4int> > fPixels;  // pixel grid per logical volume
+        std::vector<Screen*> fScreens;
+        std::vector<G4int> fSlots;      // screen per physical volume instance ID, -1 if none
+};
+
+inline G4bool ScreenImager::IsEnabled() const { return fEnabled; }
+
+#endif
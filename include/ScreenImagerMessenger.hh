@@ -0,0 +1,34 @@
+#ifndef SCREEN_IMAGER_MESSENGER_H
+#define SCREEN_IMAGER_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ScreenImagerMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class ScreenImager;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+
+class ScreenImagerMessenger : public G4UImessenger {
+    public:
+        ScreenImagerMessenger(ScreenImager*);
+        ~ScreenImagerMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        ScreenImager*     fImager;
+        G4UIdirectory*    fDirectory;
+        G4UIcmdWithABool* fImageCmd;
+        G4UIcommand*      fPixelsCmd;
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef SEED_STORE_H
+#define SEED_STORE_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for SeedStore class - reseeds the engine at the start of
+// every event and stores the two seeds, with a word of event flags, in a
+// compact binary file. In replay mode the events whose flags match a mask
+// are re-run from their stored seeds with full output.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+#include "globals.hh"
+#include "PhaseSpaceRecord.hh"
+
+class SeedStoreMessenger;
+class G4Event;
+
+// Flags set during an event
+enum EventFlag {
+    kMuonCreated = 1 << 0
+};
+
+struct SeedRecord {
+    int32_t  evid;
+    uint32_t flags;
+    int64_t  seeds[2];
+    uint64_t psIndex;       // first phase-space record of the event
+};
+
+static_assert(sizeof(SeedRecord) == 32, "SeedRecord must be 32 bytes");
+
+// Seed files use the phase-space header layout with their own magic
+static const char     kSeedStoreMagic[8] = {'A', 'P', 'O', 'L', 'S', 'D', '1', '\0'};
+static const uint32_t kSeedStoreVersion  = 1;
+
+class SeedStore {
+    public:
+        static SeedStore* Instance();
+
+    public:
+        // Master thread, start and end of run
+        void Open();
+        void Close();
+        // Worker threads
+        void BeginEvent(G4Event*);
+        void EndEvent(G4int evid, uint32_t flags);
+        void Flush();
+
+        G4bool IsRecording() const;
+        G4bool IsReplaying() const;
+        uint64_t GetPhaseSpaceIndex() const;
+        void SetPhaseSpaceIndex(uint64_t);
+
+        void SetRecording(G4bool);
+        void SetFileName(const G4String&);
+        void SetReplayMask(G4int);
+        void LoadReplay(const G4String&);
+
+    private:
+        SeedStore();
+        ~SeedStore();
+        void WriteHeader();
+
+    private:
+        SeedStoreMessenger* fMessenger;
+        G4bool fEnabled;
+        G4String fFileName;     // template, expanded like the ntuple file name
+        G4String fRunFileName;
+        std::FILE* fFile;
+        uint64_t fNRecords;
+        std::vector<std::vector<SeedRecord>*> fBuffers;    // of every thread, freed with the store
+
+        uint32_t fReplayMask;
+        std::vector<SeedRecord> fReplay;
+};
+
+inline G4bool SeedStore::IsRecording() const { return fFile != 0; }
+inline G4bool SeedStore::IsReplaying() const { return !fReplay.empty(); }
+
+#endif
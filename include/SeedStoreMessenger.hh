@@ -0,0 +1,37 @@
+#ifndef SEED_STORE_MESSENGER_H
+#define SEED_STORE_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for SeedStoreMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class SeedStore;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+
+class SeedStoreMessenger : public G4UImessenger {
+    public:
+        SeedStoreMessenger(SeedStore*);
+        ~SeedStoreMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        SeedStore*            fStore;
+        G4UIdirectory*        fDirectory;
+        G4UIcmdWithABool*     fRecordCmd;
+        G4UIcmdWithAString*   fFileNameCmd;
+        G4UIcmdWithAnInteger* fMaskCmd;
+        G4UIcmdWithAString*   fReplayCmd;
+};
+
+#endif
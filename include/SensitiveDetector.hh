@@ -4,35 +4,122 @@
 // GEANT4 simulation of the Apollon 2022 experiment.
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
-// Header file for SensitiveDetector class
-// Last edited: 07/02/2022
+// Header file for SensitiveDetector class - common base of the detector
+// classes. Handles detector IDs, boundary crossings and hit aggregation;
+// each detector keeps its own hit type and writes it to the Hits tree.
+// Last edited: 17/10/2026
 //
 
+#include <unordered_map>
+#include <vector>
+
 #include "G4VSensitiveDetector.hh"
+#include "G4ThreeVector.hh"
 
 #include "Hit.hh"
+#include "DepositHit.hh"
 #include "BDCrossing.hh"
+#include "BoundaryCache.hh"
 
 class G4HCofThisEvent;
 class G4Step;
 class G4StepPoint;
 class G4TouchableHistory;
+class DetectorIDTable;
+class DetectorConstruction;
+class EventAction;
+
+// Event layout: HitEvents and BdxEvents hold the event ID followed by a
+// block of vector columns for each SummaryDetector, in the order of the
+// columns of the flat Hits and Bdx ntuples. A detector keeping compact
+// hits has no vertex, total energy or creator process columns.
+const G4int kHitColumnsPerDetector = 13;
+const G4int kCompactHitColumnsPerDetector = 8;
+const G4int kBdxColumnsPerDetector = 16;
+
+// How energy deposits are turned into hits
+enum HitMode {
+    kHitPerStep,        // one hit per step
+    kHitPerTrack,       // one hit per track and detector
+    kHitPerVoxel        // one hit per voxel and detector
+};
 
 class SensitiveDetector : public G4VSensitiveDetector {
     public:
-        SensitiveDetector(G4String);
-        ~SensitiveDetector();
+        SensitiveDetector(G4String, const DetectorConstruction*, G4int);
+        virtual ~SensitiveDetector();
 
     public:
         virtual void Initialize(G4HCofThisEvent*);
         virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*);
         virtual void EndOfEvent(G4HCofThisEvent*);
+
+        // Event layout: whether a SummaryDetector keeps compact hits (the
+        // LANEX phosphor and the gamma spectrometer converter), and the
+        // first HitEvents column of its block
+        static G4bool KeepsCompactHits(G4int);
+        static G4int GetFirstHitColumn(G4int);
+
+    protected:
+        // Hit collection of the detector: created with the event, given a
+        // new deposit or one merged into an existing hit, written at the end
+        virtual void InitializeHits(G4HCofThisEvent*, G4int) = 0;
+        virtual std::size_t AddHit(const G4Step*, G4int, const G4ThreeVector&, G4double, G4double) = 0;
+        virtual void MergeHit(std::size_t, G4int, const G4ThreeVector&, G4double) = 0;
+        virtual std::size_t FillHits(G4int) = 0;
+
+        Hit* NewHit(const G4Step*, G4int, const G4ThreeVector&, G4double, G4double) const;
+        // Instantiated for Hit and DepositHit
+        template<class HitType> void FillHitRow(G4int, const HitType*) const;
+        // Event layout: the whole collection is appended to the vector
+        // columns of this detector
+        template<class HitType> void FillHitColumns(const std::vector<HitType*>&) const;
+
+    protected:
+        // Largest hit collection seen so far, reserved up front each event
+        std::size_t fHitCapacity;
+        G4bool fEventLayout;
         
     private:
-        HitCollection* fHitCollection;
+        // Deposits merged into one hit share a key: detector ID plus the
+        // track ID, or plus the voxel indices
+        struct HitKey {
+            G4int detid;
+            G4int ii, jj, kk;
+            bool operator==(const HitKey& other) const {
+                return detid == other.detid && ii == other.ii && jj == other.jj && kk == other.kk;
+            }
+        };
+        struct HitKeyHash {
+            std::size_t operator()(const HitKey& key) const {
+                std::size_t hh = key.detid;
+                hh = hh*1000003u ^ static_cast<std::size_t>(key.ii);
+                hh = hh*1000003u ^ static_cast<std::size_t>(key.jj);
+                hh = hh*1000003u ^ static_cast<std::size_t>(key.kk);
+                return hh;
+            }
+        };
+
+        void RecordCrossing(const G4Step*, G4int);
+        void FillBdxRows(G4int) const;
+        void FillBdxColumns() const;
+
+    private:
+        const DetectorConstruction* fDetector;
+        const DetectorIDTable* fDetectorIDs;
+        EventAction* fEventAction;
+        G4int fSummaryDetector;     // SummaryDetector in EventAction.hh
+        BoundaryCache fBoundaries;
         BDXCollection* fBDXCollection;
         G4int fHCID;
         G4int fBXCID;
+        std::size_t fBDXCapacity;
+
+        // Hit aggregation, configured through the detector construction
+        G4int fHitMode;
+        G4ThreeVector fVoxelSize;
+        G4bool fRecordCrossings;
+        std::unordered_map<HitKey, std::size_t, HitKeyHash> fHitMap;    // index into the hit collection
 };
 
-#endif
\ No newline at end of file
+#endif
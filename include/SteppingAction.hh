@@ -5,24 +5,36 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Header file for SteppingAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
 #include "G4UserSteppingAction.hh"
 
-class EventAction;
+class PhaseSpaceWriter;
+class ScoringMeshManager;
+class ScreenImager;
+class Cr39Scorer;
+class TrackLengthFluence;
+class EnergyLedger;
+class MuonTruthStore;
 class G4Step;
 
 class SteppingAction : public G4UserSteppingAction {
     public:
-        SteppingAction(EventAction*);
+        SteppingAction();
         ~SteppingAction();
 
     public:
         virtual void UserSteppingAction(const G4Step*);
 
     private:
-        EventAction* fEventAction;
+        PhaseSpaceWriter* fPhaseSpaceWriter;
+        ScoringMeshManager* fMeshManager;
+        ScreenImager* fScreenImager;
+        Cr39Scorer* fCr39Scorer;
+        TrackLengthFluence* fFluence;
+        EnergyLedger* fLedger;
+        MuonTruthStore* fMuonTruth;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef TALLY_ACCUMULABLE_H
+#define TALLY_ACCUMULABLE_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for TallyAccumulable class - per-event sums and sums of
+// squares of the convergence tallies, merged over threads by the
+// accumulable manager at the end of the run.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+#include "G4VAccumulable.hh"
+
+class TallyAccumulable : public G4VAccumulable {
+    public:
+        TallyAccumulable();
+        ~TallyAccumulable();
+
+    public:
+        virtual void Merge(const G4VAccumulable&);
+        virtual void Reset();
+
+        void Resize(std::size_t);
+        void Fill(const std::vector<G4double>&);
+
+        G4double GetEvents() const;
+        G4double GetSum(std::size_t) const;
+        G4double GetSum2(std::size_t) const;
+
+        // Relative error of the mean from n, sum and sum of squares
+        static G4double RelativeError(G4double, G4double, G4double);
+
+    private:
+        G4double fEvents;
+        std::vector<G4double> fSum;
+        std::vector<G4double> fSum2;
+};
+
+inline G4double TallyAccumulable::GetEvents() const { return fEvents; }
+inline G4double TallyAccumulable::GetSum(std::size_t ii) const { return fSum[ii]; }
+inline G4double TallyAccumulable::GetSum2(std::size_t ii) const { return fSum2[ii]; }
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef TRACK_LENGTH_FLUENCE_H
+#define TRACK_LENGTH_FLUENCE_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for TrackLengthFluence class - track-length estimate of the
+// fluence in whole detector volumes: the sum of step lengths in a volume
+// divided by its volume, binned in species and kinetic energy. Every step
+// inside the volume contributes, so the estimate converges much faster
+// than the boundary-crossing fluence.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <set>
+#include <vector>
+
+#include "globals.hh"
+#include "RunScorer.hh"
+#include "DenseAccumulator.hh"
+
+class TrackLengthFluenceMessenger;
+class G4Step;
+class G4LogicalVolume;
+
+enum FluenceSpecies {
+    kFluenceGamma,
+    kFluenceElectron,
+    kFluencePositron,
+    kFluenceMuon,
+    kFluenceProton,
+    kFluenceNeutron,
+    kFluenceOther,
+    kFluenceNSpecies
+};
+
+class TrackLengthFluence : public RunScorer {
+    public:
+        static TrackLengthFluence* Instance();
+
+    public:
+        // Master thread
+        virtual void BeginOfRun();
+        virtual void Write(G4int) const;
+        // Every thread
+        virtual void ResetLocal();
+        virtual void Merge();
+        void Score(const G4Step*) const;
+
+        G4bool IsEnabled() const;
+        void SetEnabled(G4bool);
+        void AddVolume(const G4String&);
+        void SetEnergyBinning(G4int, G4double, G4double);
+
+    private:
+        TrackLengthFluence();
+        ~TrackLengthFluence();
+        void ClearDetectors();
+        void CountPlacements(const G4LogicalVolume*, G4int, std::vector<G4int>&) const;
+
+    private:
+        struct Detector {
+            G4String name;              // logical volume name
+            G4double scale;             // 1/(total volume of all placements), in 1/cm3
+            DenseAccumulator fluence;   // [species][energy bin]
+        };
+
+        TrackLengthFluenceMessenger* fMessenger;
+        G4bool fEnabled;
+        std::set<G4String> fVolumeNames;
+        G4int fNEnergy;
+        G4double fEnergyMin, fEnergyMax;
+        G4double fLogEnergyMin, fEnergyBinsPerDecade;
+
+        std::vector<Detector*> fDetectors;
+        std::vector<G4int> fSlots;      // detector per logical volume instance ID, -1 if none
+};
+
+inline G4bool TrackLengthFluence::IsEnabled() const { return fEnabled; }
+
+#endif
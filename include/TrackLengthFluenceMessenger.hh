@@ -0,0 +1,36 @@
+#ifndef TRACK_LENGTH_FLUENCE_MESSENGER_H
+#define TRACK_LENGTH_FLUENCE_MESSENGER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for TrackLengthFluenceMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class TrackLengthFluence;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+
+class TrackLengthFluenceMessenger : public G4UImessenger {
+    public:
+        TrackLengthFluenceMessenger(TrackLengthFluence*);
+        ~TrackLengthFluenceMessenger();
+
+    public:
+        virtual void SetNewValue(G4UIcommand*, G4String);
+
+    private:
+        TrackLengthFluence* fFluence;
+        G4UIdirectory*      fDirectory;
+        G4UIcmdWithABool*   fScoreCmd;
+        G4UIcmdWithAString* fVolumeCmd;
+        G4UIcommand*        fEnergyBinsCmd;
+};
+
+#endif
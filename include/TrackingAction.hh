@@ -12,18 +12,41 @@
 
 #include "G4ThreeVector.hh"
 
+// Columns of the Tracks ntuple after the event ID; TrackEvents has a
+// vector column for each in the same place
+enum TrackColumn {
+    kTrackColumnID = 1,
+    kTrackColumnPDG,
+    kTrackColumnDetID,
+    kTrackColumnProcID,
+    kTrackColumnVtxX,
+    kTrackColumnVtxY,
+    kTrackColumnVtxZ,
+    kTrackColumnEndX,
+    kTrackColumnEndY,
+    kTrackColumnEndZ,
+    kTrackColumnEnergy,
+    kTrackColumnWeight
+};
+
 class RunAction;
+class EventAction;
+class DetectorIDTable;
 class G4Track;
 
 class TrackingAction : public G4UserTrackingAction {
     public:
-        TrackingAction(RunAction*);
+        TrackingAction(RunAction*, EventAction*);
         ~TrackingAction();
 
     public:
         virtual void PreUserTrackingAction(const G4Track*);
         virtual void PostUserTrackingAction(const G4Track*);
 
+    private:
+        EventAction* fEventAction;
+        const DetectorIDTable* fDetectorIDs;
+
 };
 
 #endif
\ No newline at end of file
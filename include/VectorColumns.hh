@@ -0,0 +1,57 @@
+#ifndef VECTOR_COLUMNS_H
+#define VECTOR_COLUMNS_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for VectorColumns class - the vectors bound to the vector
+// columns booked on one thread. The analysis manager reads them when a
+// row is added, so a batch being replayed loads the values of its event
+// into them just before; real values are converted to the storage format
+// of their column on the way.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <vector>
+
+#include "globals.hh"
+#include "ColumnFormat.hh"
+
+class G4VAnalysisManager;
+class OutputBatch;
+
+class VectorColumns {
+    public:
+        VectorColumns();
+        ~VectorColumns();
+
+    public:
+        // Same arguments as the analysis manager calls, plus the storage
+        // format of a real column
+        G4int CreateIColumn(G4VAnalysisManager*, G4int, const G4String&);
+        G4int CreateRealColumn(G4VAnalysisManager*, G4int, const G4String&, const ColumnFormat&);
+        // Columns booked from here on belong to a new run
+        void BeginOfRun();
+        // Bound vectors of the ntuple take the values the batch holds for them
+        void Load(G4int, const OutputBatch&);
+
+    private:
+        struct Binding {
+            G4int ntuple;
+            G4int column;
+            G4bool real;
+            ColumnFormat format;
+            std::vector<G4int> ints;        // integer and fixed-point columns
+            std::vector<G4float> floats;
+            std::vector<G4double> doubles;
+        };
+
+    private:
+        std::vector<Binding*> fBindings;
+        // Still referenced by the ntuples of earlier runs, which the
+        // analysis manager may keep until it is deleted
+        std::vector<Binding*> fRetired;
+};
+
+#endif
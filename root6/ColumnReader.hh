@@ -0,0 +1,84 @@
+#ifndef COLUMN_READER_H
+#define COLUMN_READER_H 1
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Header file for ColumnReader class. Reads a real-valued column of the
+// Hits or Bdx trees whatever its storage - double, float, or fixed point
+// with the scale listed in the Formats tree - and returns it as a double.
+// Files written before the Formats tree existed are read as doubles.
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <map>
+#include <string>
+#include <vector>
+
+#include "TTree.h"
+#include "TChain.h"
+#include "TLeaf.h"
+
+typedef std::map<std::string, double> ColumnScales;
+
+// Fixed-point scales of the columns of one tree, by column name
+inline ColumnScales ReadColumnScales(const std::vector<std::string>& flist, const std::string& treename) {
+
+    ColumnScales scales;
+    TChain formats("Formats");
+    for (size_t ii = 0; ii < flist.size(); ++ii) formats.Add(flist[ii].c_str(), -1);
+    if (formats.GetEntries() <= 0) return scales;
+
+    char ntuple[256], column[256], storage[256];
+    double scale;
+    formats.SetBranchAddress("ntuple", ntuple);
+    formats.SetBranchAddress("column", column);
+    formats.SetBranchAddress("storage", storage);
+    formats.SetBranchAddress("scale", &scale);
+    for (Long64_t ii = 0; ii < formats.GetEntries(); ++ii) {
+        formats.GetEntry(ii);
+        if (treename == ntuple && std::string(storage) == "fixed") scales[column] = scale;
+    }
+    return scales;
+}
+
+class ColumnReader {
+    public:
+        ColumnReader() : fType(kDouble), fDouble(0.), fFloat(0.f), fInt(0), fScale(1.) {}
+
+    public:
+        void Bind(TTree* tree, const std::string& column, const ColumnScales& scales) {
+            TLeaf* leaf = tree->GetLeaf(column.c_str());
+            std::string type = leaf ? leaf->GetTypeName() : "Double_t";
+            if (type == "Float_t") {
+                fType = kFloat;
+                tree->SetBranchAddress(column.c_str(), &fFloat);
+            }
+            else if (type == "Int_t") {
+                fType = kFixed;
+                tree->SetBranchAddress(column.c_str(), &fInt);
+            }
+            else {
+                fType = kDouble;
+                tree->SetBranchAddress(column.c_str(), &fDouble);
+            }
+            ColumnScales::const_iterator it = scales.find(column);
+            fScale = (it != scales.end()) ? it->second : 1.;
+        }
+
+        double Value() const {
+            if (fType == kFloat) return fFloat;
+            if (fType == kFixed) return fInt*fScale;
+            return fDouble;
+        }
+
+    private:
+        enum { kDouble, kFloat, kFixed } fType;
+        double fDouble;
+        float  fFloat;
+        int    fInt;
+        double fScale;
+};
+
+#endif
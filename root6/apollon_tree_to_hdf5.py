@@ -9,7 +9,7 @@
 #         - ROOT (PyROOT)
 #
 # Created: 18/05/2022
-# Last modified: 18/05/2022
+# Last modified: 17/10/2026
 ###############################################################################
 ###############################################################################
 import sys
@@ -28,6 +28,23 @@ def ttree_to_hdf5(hfile: h5py.File , tree: ROOT.TChain) -> None:
         print(f'Dataset {dset.name} created.')
 #
 #
+def read_column_scales(fnames: list, treename: str) -> dict:
+    # Fixed-point columns are stored as integer steps of the scale listed
+    # in the Formats tree; floats and doubles need no conversion
+    scales = {}
+    formats = ROOT.TChain("Formats")
+    for fname in fnames: formats.Add(fname, -1)
+    if formats.GetEntries() <= 0: return scales
+    for entry in formats:
+        if str(entry.ntuple) == treename and str(entry.storage) == 'fixed':
+            scales[str(entry.column)] = entry.scale
+    return scales
+#
+#
+def column(entry, name: str, scales: dict) -> float:
+    return getattr(entry, name)*scales.get(name, 1.)
+#
+#
 def main() -> int:
     flistname = sys.argv[1]
     print(flistname)
@@ -38,11 +55,15 @@ def main() -> int:
     primaryTree = ROOT.TChain("Primaries")
     hitsTree    = ROOT.TChain("Hits")
     bdxTree     = ROOT.TChain("Bdx")
+    fnames = []
     for fname in flist: 
         primaryTree.Add(fname.strip('\n'), -1)             # Need to strip 
                                                            # newline character.
         hitsTree.Add(fname.strip('\n'), -1)
         bdxTree.Add(fname.strip('\n'), -1)
+        fnames.append(fname.strip('\n'))
+    hitsScales = read_column_scales(fnames, 'Hits')
+    bdxScales = read_column_scales(fnames, 'Bdx')
 
     print(f'Nentries in primaryTree: {primaryTree.GetEntries()}')
     print(f'Nentries in hitsTree: {hitsTree.GetEntries()}')
@@ -62,6 +83,8 @@ def main() -> int:
         hfile[groupName + '/' + 'z'][ii]     = entry.z
         hfile[groupName + '/' + 'theta'][ii] = entry.theta
         hfile[groupName + '/' + 'phi'][ii]   = entry.phi
+        hfile[groupName + '/' + 'evid'][ii]  = entry.evid
+        hfile[groupName + '/' + 'weight'][ii] = entry.weight
         ii += 1
 
     groupName = hitsTree.GetName()
@@ -69,16 +92,17 @@ def main() -> int:
     for entry in hitsTree:
         if (ii%1000 == 0): print(f'Processed {ii} entries of {hitsTree.GetEntries()}...')
         hfile[groupName + '/' + 'evid'][ii] = entry.evid
-        hfile[groupName + '/' + 'x'][ii] = entry.x
-        hfile[groupName + '/' + 'y'][ii] = entry.y
-        hfile[groupName + '/' + 'z'][ii] = entry.z
-        hfile[groupName + '/' + 'vtxx'][ii] = entry.vtxx
-        hfile[groupName + '/' + 'vtxy'][ii] = entry.vtxy
-        hfile[groupName + '/' + 'vtxz'][ii] = entry.vtxz
-        hfile[groupName + '/' + 'edep'][ii] = entry.edep
-        hfile[groupName + '/' + 'energy'][ii] = entry.energy
+        hfile[groupName + '/' + 'x'][ii] = column(entry, 'x', hitsScales)
+        hfile[groupName + '/' + 'y'][ii] = column(entry, 'y', hitsScales)
+        hfile[groupName + '/' + 'z'][ii] = column(entry, 'z', hitsScales)
+        hfile[groupName + '/' + 'vtxx'][ii] = column(entry, 'vtxx', hitsScales)
+        hfile[groupName + '/' + 'vtxy'][ii] = column(entry, 'vtxy', hitsScales)
+        hfile[groupName + '/' + 'vtxz'][ii] = column(entry, 'vtxz', hitsScales)
+        hfile[groupName + '/' + 'edep'][ii] = column(entry, 'edep', hitsScales)
+        hfile[groupName + '/' + 'energy'][ii] = column(entry, 'energy', hitsScales)
         hfile[groupName + '/' + 'pdg'][ii] = entry.pdg
         hfile[groupName + '/' + 'detid'][ii] = entry.detid
+        hfile[groupName + '/' + 'weight'][ii] = column(entry, 'weight', hitsScales)
         ii += 1
 
     groupName = bdxTree.GetName()
@@ -89,18 +113,19 @@ def main() -> int:
         hfile[groupName + '/' + 'detid'][ii] = entry.detid
         hfile[groupName + '/' + 'pdg'][ii] = entry.pdg
         hfile[groupName + '/' + 'procid'][ii] = entry.procid
-        hfile[groupName + '/' + 'x'][ii] = entry.x
-        hfile[groupName + '/' + 'y'][ii] = entry.y
-        hfile[groupName + '/' + 'z'][ii] = entry.z
-        hfile[groupName + '/' + 'vtxx'][ii] = entry.vtxx
-        hfile[groupName + '/' + 'vtxy'][ii] = entry.vtxy
-        hfile[groupName + '/' + 'vtxz'][ii] = entry.vtxz
-        hfile[groupName + '/' + 'px'][ii] = entry.px
-        hfile[groupName + '/' + 'py'][ii] = entry.py
-        hfile[groupName + '/' + 'pz'][ii] = entry.pz
-        hfile[groupName + '/' + 'energy'][ii] = entry.energy
-        hfile[groupName + '/' + 'theta'][ii] = entry.theta
-        hfile[groupName + '/' + 'fluence'][ii] = entry.fluence
+        hfile[groupName + '/' + 'x'][ii] = column(entry, 'x', bdxScales)
+        hfile[groupName + '/' + 'y'][ii] = column(entry, 'y', bdxScales)
+        hfile[groupName + '/' + 'z'][ii] = column(entry, 'z', bdxScales)
+        hfile[groupName + '/' + 'vtxx'][ii] = column(entry, 'vtxx', bdxScales)
+        hfile[groupName + '/' + 'vtxy'][ii] = column(entry, 'vtxy', bdxScales)
+        hfile[groupName + '/' + 'vtxz'][ii] = column(entry, 'vtxz', bdxScales)
+        hfile[groupName + '/' + 'px'][ii] = column(entry, 'px', bdxScales)
+        hfile[groupName + '/' + 'py'][ii] = column(entry, 'py', bdxScales)
+        hfile[groupName + '/' + 'pz'][ii] = column(entry, 'pz', bdxScales)
+        hfile[groupName + '/' + 'energy'][ii] = column(entry, 'energy', bdxScales)
+        hfile[groupName + '/' + 'theta'][ii] = column(entry, 'theta', bdxScales)
+        hfile[groupName + '/' + 'fluence'][ii] = column(entry, 'fluence', bdxScales)
+        hfile[groupName + '/' + 'weight'][ii] = column(entry, 'weight', bdxScales)
         ii += 1
     
     print(f'Finished compiling {hfile.filename}. Closing...')
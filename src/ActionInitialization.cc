@@ -3,7 +3,7 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Source file for ActionInitialization class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
 #include "ActionInitialization.hh"
@@ -38,10 +38,10 @@ void ActionInitialization::Build() const {
 	EventAction* eventAction = new EventAction(runAction);
 	SetUserAction(eventAction);
 
-	SteppingAction* steppingAction = new SteppingAction(eventAction);
+	SteppingAction* steppingAction = new SteppingAction();
 	SetUserAction(steppingAction);
 
-	TrackingAction* trackingAction = new TrackingAction(runAction);
+	TrackingAction* trackingAction = new TrackingAction(runAction, eventAction);
 	SetUserAction(trackingAction);
 
     return;
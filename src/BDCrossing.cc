@@ -11,8 +11,10 @@
 
 #include "G4VProcess.hh"
 
+G4ThreadLocal G4Allocator<BDCrossing>* BDCrossingAllocator = 0;
+
 BDCrossing::BDCrossing(): fPdg(0), fDetid(0), fVertex(0), fPosition(0),
-             fEnergy(0.), fMomentum(0), fAngle(0.), fFluence(0.), fProcid(0)
+             fEnergy(0.), fMomentum(0), fAngle(0.), fFluence(0.), fProcid(0), fWeight(1.)
 {}
 
 BDCrossing::~BDCrossing()
@@ -41,6 +43,7 @@ void BDCrossing::SetFluence(G4ThreeVector surfNorm, G4double areaS) {
     } 
 }
 void BDCrossing::SetCreatorProcess(G4int procid) { fProcid = procid; }
+void BDCrossing::SetWeight(G4double weight) { fWeight = weight; }
 
 //
 //
@@ -53,4 +56,5 @@ G4double BDCrossing::GetEnergy() const { return fEnergy; }
 G4ThreeVector BDCrossing::GetMomentum() const { return fMomentum; }
 G4double BDCrossing::GetAngle() const { return fAngle; }
 G4double BDCrossing::GetFluence() const { return fFluence; }
-G4int BDCrossing::GetProcessID() const { return fProcid; }
\ No newline at end of file
+G4int BDCrossing::GetProcessID() const { return fProcid; }
+G4double BDCrossing::GetWeight() const { return fWeight; }
\ No newline at end of file
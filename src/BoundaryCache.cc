@@ -0,0 +1,64 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for BoundaryCache class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cmath>
+
+#include "BoundaryCache.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Box.hh"
+
+BoundaryCache::BoundaryCache()
+{}
+
+BoundaryCache::~BoundaryCache()
+{}
+
+const BoundaryCache::Entry& BoundaryCache::Get(const G4LogicalVolume* volume) {
+
+    std::size_t index = volume->GetInstanceID();
+    if (index >= fEntries.size()) {
+        Entry empty = {0, false, G4ThreeVector(), 0.};
+        fEntries.resize(index + 1, empty);
+    }
+
+    // A rebuilt geometry may give the volume a new solid
+    Entry& entry = fEntries[index];
+    const G4VSolid* solid = volume->GetSolid();
+    if (entry.solid != solid) Fill(entry, solid);
+    return entry;
+}
+
+void BoundaryCache::Fill(Entry& entry, const G4VSolid* solid) const {
+
+    G4VSolid* theSolid = const_cast<G4VSolid*>(solid);  // GetSurfaceArea is not const
+    const G4Box* box = dynamic_cast<const G4Box*>(solid);
+
+    entry.solid = solid;
+    entry.isBox = (box != 0);
+    if (box) {
+        entry.halfLength.set(box->GetXHalfLength(), box->GetYHalfLength(), box->GetZHalfLength());
+    }
+    entry.halfArea = 0.5*theSolid->GetSurfaceArea();
+}
+
+G4ThreeVector BoundaryCache::GetNormal(const Entry& entry, const G4ThreeVector& localPosition) const {
+
+    if (!entry.isBox) return entry.solid->SurfaceNormal(localPosition);
+
+    // The crossed face is the one the point lies closest to, relative to
+    // the half-length along each axis
+    G4double rx = std::abs(localPosition.x())/entry.halfLength.x();
+    G4double ry = std::abs(localPosition.y())/entry.halfLength.y();
+    G4double rz = std::abs(localPosition.z())/entry.halfLength.z();
+    if (rx >= ry && rx >= rz) return G4ThreeVector(localPosition.x() < 0. ? -1. : 1., 0., 0.);
+    if (ry >= rz) return G4ThreeVector(0., localPosition.y() < 0. ? -1. : 1., 0.);
+    return G4ThreeVector(0., 0., localPosition.z() < 0. ? -1. : 1.);
+}
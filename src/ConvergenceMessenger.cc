@@ -0,0 +1,65 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ConvergenceMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "ConvergenceMessenger.hh"
+#include "ConvergenceMonitor.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+ConvergenceMessenger::ConvergenceMessenger(ConvergenceMonitor* monitor) : G4UImessenger(), fMonitor(monitor) {
+
+    fDirectory = new G4UIdirectory("/convergence/");
+    fDirectory->SetGuidance("Relative error of per-event tallies, and ending the run at a target precision.");
+
+    fTallyCmd = new G4UIcmdWithAString("/convergence/tally", this);
+    fTallyCmd->SetGuidance("Follow a column of the Events ntuple, e.g. cr39_nmu or lanex_edep.");
+    fTallyCmd->SetParameterName("column", false);
+    fTallyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fTallyCmd->SetToBeBroadcasted(false);
+
+    fClearTalliesCmd = new G4UIcmdWithoutParameter("/convergence/clearTallies", this);
+    fClearTalliesCmd->SetGuidance("Stop following all tallies.");
+    fClearTalliesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fClearTalliesCmd->SetToBeBroadcasted(false);
+
+    fPrecisionCmd = new G4UIcmdWithADouble("/convergence/precision", this);
+    fPrecisionCmd->SetGuidance("End the run once every tally has this relative error (0 runs all events).");
+    fPrecisionCmd->SetParameterName("precision", false);
+    fPrecisionCmd->SetRange("precision>=0.");
+    fPrecisionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPrecisionCmd->SetToBeBroadcasted(false);
+
+    fIntervalCmd = new G4UIcmdWithAnInteger("/convergence/interval", this);
+    fIntervalCmd->SetGuidance("Number of events each thread runs between updates of the relative error.");
+    fIntervalCmd->SetParameterName("interval", false);
+    fIntervalCmd->SetRange("interval>0");
+    fIntervalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fIntervalCmd->SetToBeBroadcasted(false);
+}
+
+ConvergenceMessenger::~ConvergenceMessenger() {
+    delete fDirectory;
+    delete fTallyCmd;
+    delete fClearTalliesCmd;
+    delete fPrecisionCmd;
+    delete fIntervalCmd;
+}
+
+void ConvergenceMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fTallyCmd) fMonitor->AddTally(newValue);
+    if (command == fClearTalliesCmd) fMonitor->ClearTallies();
+    if (command == fPrecisionCmd) fMonitor->SetPrecision(fPrecisionCmd->GetNewDoubleValue(newValue));
+    if (command == fIntervalCmd) fMonitor->SetInterval(fIntervalCmd->GetNewIntValue(newValue));
+
+}
@@ -0,0 +1,161 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ConvergenceMonitor class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "ConvergenceMonitor.hh"
+#include "ConvergenceMessenger.hh"
+#include "TallyAccumulable.hh"
+#include "EventAction.hh"
+
+#include "G4AutoLock.hh"
+#include "G4RunManager.hh"
+
+namespace {
+    G4Mutex monitorMutex = G4MUTEX_INITIALIZER;
+
+    // Sums of this thread not yet published
+    struct PendingSums {
+        G4int events;
+        std::vector<G4double> sum;
+        std::vector<G4double> sum2;
+    };
+    G4ThreadLocal PendingSums* pending = 0;
+}
+
+ConvergenceMonitor* ConvergenceMonitor::Instance() {
+    static ConvergenceMonitor theMonitor;
+    return &theMonitor;
+}
+
+ConvergenceMonitor::ConvergenceMonitor() : fMessenger(0), fPrecision(0.), fInterval(1000), fEvents(0.),
+                                           fStopRequested(false) {
+    fMessenger = new ConvergenceMessenger(this);
+}
+
+ConvergenceMonitor::~ConvergenceMonitor() {
+    delete fMessenger;
+}
+
+void ConvergenceMonitor::BeginOfRun() {
+
+    // Names are resolved once the geometry, and so the Cr-39 stacks, exist
+    std::vector<G4String> names;
+    fTallyColumns.clear();
+    for (std::size_t ii = 0; ii < fTallyNames.size(); ++ii) {
+        G4int column = EventAction::FindColumn(fTallyNames[ii]);
+        if (column < 0) {
+            G4ExceptionDescription msg;
+            msg << "No Events column " << fTallyNames[ii] << " to use as a tally; tally removed.";
+            G4Exception("ConvergenceMonitor::BeginOfRun", "Apollon024", JustWarning, msg);
+            continue;
+        }
+        names.push_back(fTallyNames[ii]);
+        fTallyColumns.push_back(column);
+    }
+    fTallyNames = names;
+
+    fEvents = 0.;
+    fSum.assign(fTallyColumns.size(), 0.);
+    fSum2.assign(fTallyColumns.size(), 0.);
+    fStopRequested.store(false);
+    fStartTime = std::chrono::steady_clock::now();
+}
+
+void ConvergenceMonitor::ResetLocal() {
+    if (pending) pending->sum.clear();
+}
+
+G4double ConvergenceMonitor::GetElapsedTime() const {
+    return std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fStartTime).count();
+}
+
+void ConvergenceMonitor::EndEvent(const std::vector<G4double>& values) {
+
+    if (!pending) pending = new PendingSums();
+    if (pending->sum.size() != fTallyColumns.size()) {
+        pending->events = 0;
+        pending->sum.assign(fTallyColumns.size(), 0.);
+        pending->sum2.assign(fTallyColumns.size(), 0.);
+    }
+
+    pending->events += 1;
+    for (std::size_t ii = 0; ii < values.size(); ++ii) {
+        pending->sum[ii] += values[ii];
+        pending->sum2[ii] += values[ii]*values[ii];
+    }
+    if (pending->events >= fInterval) Publish();
+
+    // Every thread finishes its current event and stops
+    if (IsStopRequested()) G4RunManager::GetRunManager()->AbortRun(true);
+}
+
+void ConvergenceMonitor::Publish() {
+
+    // The totals are copied under the lock and printed once it is released
+    G4double events = 0.;
+    std::vector<G4double> sum, sum2;
+    {
+        G4AutoLock lock(&monitorMutex);
+
+        fEvents += pending->events;
+        for (std::size_t ii = 0; ii < fSum.size(); ++ii) {
+            fSum[ii] += pending->sum[ii];
+            fSum2[ii] += pending->sum2[ii];
+        }
+        pending->events = 0;
+        pending->sum.assign(pending->sum.size(), 0.);
+        pending->sum2.assign(pending->sum2.size(), 0.);
+
+        events = fEvents;
+        sum = fSum;
+        sum2 = fSum2;
+    }
+
+    G4double elapsed = GetElapsedTime();
+    G4bool converged = fPrecision > 0.;
+    G4cout << "Convergence after " << events << " events (" << elapsed << " s):";
+    for (std::size_t ii = 0; ii < sum.size(); ++ii) {
+        G4double error = TallyAccumulable::RelativeError(events, sum[ii], sum2[ii]);
+        G4double merit = (elapsed > 0.) ? 1./(error*error*elapsed) : 0.;
+        G4cout << " " << fTallyNames[ii] << " R = " << error << " FOM = " << merit << ";";
+        if (!(error <= fPrecision)) converged = false;
+    }
+    G4cout << G4endl;
+
+    if (converged && !fStopRequested.exchange(true)) {
+        G4cout << "Target relative error " << fPrecision << " reached; ending the run." << G4endl;
+    }
+}
+
+void ConvergenceMonitor::Report(const TallyAccumulable& tallies) const {
+
+    if (fTallyColumns.empty()) return;
+
+    G4double elapsed = GetElapsedTime();
+    G4cout << "Tallies over " << tallies.GetEvents() << " events (" << elapsed << " s):" << G4endl;
+    for (std::size_t ii = 0; ii < fTallyColumns.size(); ++ii) {
+        G4double error = TallyAccumulable::RelativeError(tallies.GetEvents(), tallies.GetSum(ii), tallies.GetSum2(ii));
+        G4double merit = (elapsed > 0.) ? 1./(error*error*elapsed) : 0.;
+        G4double mean = (tallies.GetEvents() > 0.) ? tallies.GetSum(ii)/tallies.GetEvents() : 0.;
+        G4cout << "    " << fTallyNames[ii] << ": mean " << mean << " per event, R = " << error << ", FOM = "
+               << merit << G4endl;
+    }
+}
+
+void ConvergenceMonitor::AddTally(const G4String& name) {
+    fTallyNames.push_back(name);
+}
+
+void ConvergenceMonitor::ClearTallies() {
+    fTallyNames.clear();
+    fTallyColumns.clear();
+}
+
+void ConvergenceMonitor::SetPrecision(G4double precision) { fPrecision = precision; }
+
+void ConvergenceMonitor::SetInterval(G4int interval) { fInterval = interval; }
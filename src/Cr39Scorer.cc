@@ -0,0 +1,229 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for Cr39Scorer class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "Cr39Scorer.hh"
+#include "Cr39ScorerMessenger.hh"
+#include "OutputManager.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4VTouchable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace {
+    const char* speciesNames[kCr39NSpecies] = {"muon", "electron", "proton", "other"};
+
+    // Path of the current track through one layer. A track's steps in a
+    // layer are consecutive, so one open segment per thread is enough.
+    struct Segment {
+        G4bool open;
+        G4int trackID;
+        std::size_t bin;            // [stack][layer][species]
+        G4double edep;
+        G4double length;
+        G4double weight;
+    };
+    G4ThreadLocal Segment* segment = 0;
+}
+
+Cr39Scorer* Cr39Scorer::Instance() {
+    static Cr39Scorer theScorer;
+    return &theScorer;
+}
+
+Cr39Scorer::Cr39Scorer() : fMessenger(0), fEnabled(false), fNLET(60), fLETMin(0.1), fLETMax(1000.),
+                           fLayerVolume(0), fNLayers(0), fLogLETMin(0.), fLETBinsPerDecade(0.) {
+    fMessenger = new Cr39ScorerMessenger(this);
+}
+
+Cr39Scorer::~Cr39Scorer() {
+    delete fMessenger;
+}
+
+void Cr39Scorer::BeginOfRun() {
+
+    fLayerVolume = 0;
+    fStackSlots.clear();
+    fStackNames.clear();
+    fNLayers = 0;
+    if (!fEnabled) return;
+
+    // Layers are the replicas of lCr39; stacks are the placements of their mother
+    const G4PhysicalVolumeStore* store = G4PhysicalVolumeStore::GetInstance();
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        const G4VPhysicalVolume* volume = (*store)[ii];
+        if (volume->GetLogicalVolume()->GetName() == "lCr39") {
+            fLayerVolume = volume->GetLogicalVolume();
+            fNLayers = volume->GetMultiplicity();
+        }
+    }
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        const G4VPhysicalVolume* volume = (*store)[ii];
+        if (!fLayerVolume || volume->GetLogicalVolume()->GetName() != "lStack") continue;
+
+        std::size_t index = volume->GetInstanceID();
+        if (index >= fStackSlots.size()) fStackSlots.resize(index + 1, -1);
+        fStackSlots[index] = fStackNames.size();
+        fStackNames.push_back(volume->GetName());
+    }
+    if (!fLayerVolume || fStackNames.empty()) {
+        G4Exception("Cr39Scorer::BeginOfRun", "Apollon020", JustWarning,
+                    "No Cr-39 stacks (lStack with lCr39 layers) in the geometry; Cr-39 scoring disabled for this run.");
+        fLayerVolume = 0;
+        return;
+    }
+
+    fLogLETMin = std::log10(fLETMin);
+    fLETBinsPerDecade = fNLET/(std::log10(fLETMax) - fLogLETMin);
+
+    std::size_t nbins = fStackNames.size()*fNLayers*kCr39NSpecies;
+    fCounts.Resize(nbins);
+    fLET.Resize(nbins*fNLET);
+}
+
+void Cr39Scorer::ResetLocal() {
+    if (segment) segment->open = false;
+    fCounts.ResetLocal();
+    fLET.ResetLocal();
+}
+
+void Cr39Scorer::Merge() {
+    fCounts.Merge();
+    fLET.Merge();
+}
+
+void Cr39Scorer::Score(const G4Step* aStep) const {
+
+    const G4StepPoint* preStepPoint = aStep->GetPreStepPoint();
+    if (!fLayerVolume || preStepPoint->GetPhysicalVolume()->GetLogicalVolume() != fLayerVolume) return;
+
+    const G4Track* track = aStep->GetTrack();
+    const G4ParticleDefinition* particle = track->GetParticleDefinition();
+    if (particle->GetPDGCharge() == 0.) return;
+
+    if (!segment) {
+        segment = new Segment();
+        segment->open = false;
+    }
+
+    // A new segment is opened when the track enters the layer; particles
+    // created inside a layer are not counted
+    const G4VTouchable* touchable = preStepPoint->GetTouchable();
+    if (!segment->open || segment->trackID != track->GetTrackID()) {
+        if (segment->open) CloseSegment();
+        if (preStepPoint->GetStepStatus() != fGeomBoundary) return;
+
+        std::size_t stackIndex = touchable->GetVolume(1)->GetInstanceID();
+        if (stackIndex >= fStackSlots.size() || fStackSlots[stackIndex] < 0) return;
+
+        G4int pdg = std::abs(particle->GetPDGEncoding());
+        G4int species = kCr39OtherCharged;
+        if (pdg == 13) species = kCr39Muon;
+        else if (pdg == 11) species = kCr39Electron;
+        else if (pdg == 2212) species = kCr39Proton;
+
+        segment->open = true;
+        segment->trackID = track->GetTrackID();
+        segment->bin = (static_cast<std::size_t>(fStackSlots[stackIndex])*fNLayers + touchable->GetReplicaNumber())
+                       *kCr39NSpecies + species;
+        segment->edep = 0.;
+        segment->length = 0.;
+        segment->weight = preStepPoint->GetWeight();
+    }
+
+    segment->edep += aStep->GetTotalEnergyDeposit();
+    segment->length += aStep->GetStepLength();
+
+    // The segment ends when the track leaves the layer or stops in it
+    if (aStep->GetPostStepPoint()->GetStepStatus() == fGeomBoundary || track->GetTrackStatus() != fAlive) {
+        CloseSegment();
+    }
+}
+
+void Cr39Scorer::CloseSegment() const {
+
+    segment->open = false;
+    fCounts.Add(segment->bin, segment->weight);
+    if (segment->length <= 0.) return;
+
+    // LET bins are logarithmic; values outside the range go to the end bins
+    G4double let = (segment->edep/keV)/(segment->length/um);
+    G4int letBin = 0;
+    if (let > 0.) {
+        letBin = static_cast<G4int>(std::floor((std::log10(let) - fLogLETMin)*fLETBinsPerDecade));
+        if (letBin < 0) letBin = 0;
+        if (letBin >= fNLET) letBin = fNLET - 1;
+    }
+    fLET.Add(segment->bin*fNLET + letBin, segment->weight);
+}
+
+void Cr39Scorer::Write(G4int nEvents) const {
+
+    if (!fLayerVolume) return;
+
+    // Count table, one line per stack, layer and species
+    const std::vector<G4double>& counts = fCounts.GetTotal();
+    OutputManager* outputManager = OutputManager::Instance();
+    G4String tableName = outputManager->GetRunFileName("cr39_counts.txt");
+    G4String letName = outputManager->GetRunFileName("cr39_let.score");
+    std::ofstream table(tableName);
+    table << "# Cr-39 layer counts: weighted number of charged particles entering each layer" << std::endl;
+    table << "# events " << nEvents << std::endl;
+    table << "# stack layer species count" << std::endl;
+    for (std::size_t ss = 0; ss < fStackNames.size(); ++ss) {
+        for (G4int ll = 0; ll < fNLayers; ++ll) {
+            for (G4int kk = 0; kk < kCr39NSpecies; ++kk) {
+                std::size_t bin = (ss*fNLayers + ll)*kCr39NSpecies + kk;
+                table << fStackNames[ss] << " " << ll << " " << speciesNames[kk] << " " << counts[bin] << std::endl;
+            }
+        }
+    }
+    table.close();
+
+    // LET spectra, stack x layer x species x LET
+    ScoreFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.rank = 4;
+    header.shape[0] = fStackNames.size();
+    header.shape[1] = fNLayers;
+    header.shape[2] = kCr39NSpecies;
+    header.shape[3] = fNLET;
+    header.upper[0] = fStackNames.size();
+    header.upper[1] = fNLayers;
+    header.upper[2] = kCr39NSpecies;
+    header.lower[3] = fLETMin;
+    header.upper[3] = fLETMax;
+    header.logAxes = 1 << 3;
+    header.nEvents = nEvents;
+    std::strncpy(header.quantity, "LET", sizeof(header.quantity) - 1);
+    std::strncpy(header.unit, "keV/um", sizeof(header.unit) - 1);
+    fLET.Write(letName, header);
+
+    G4cout << "Cr-39 scores written to " << tableName << " and " << letName << " (" << fStackNames.size() << " stacks, "
+           << fNLayers << " layers)." << G4endl;
+}
+
+void Cr39Scorer::SetEnabled(G4bool val) { fEnabled = val; }
+
+void Cr39Scorer::SetLETBinning(G4int nbins, G4double letMin, G4double letMax) {
+    fNLET = nbins;
+    fLETMin = letMin;
+    fLETMax = letMax;
+}
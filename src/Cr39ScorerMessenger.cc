@@ -0,0 +1,68 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for Cr39ScorerMessenger class
+// Last edited: 17/10/2026
+//
+
+#include <sstream>
+
+#include "Cr39ScorerMessenger.hh"
+#include "Cr39Scorer.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+
+Cr39ScorerMessenger::Cr39ScorerMessenger(Cr39Scorer* scorer) : G4UImessenger(), fScorer(scorer) {
+
+    fDirectory = new G4UIdirectory("/cr39/");
+    fDirectory->SetGuidance("Layer counts and LET spectra in the Cr-39 stacks.");
+
+    fScoreCmd = new G4UIcmdWithABool("/cr39/score", this);
+    fScoreCmd->SetGuidance("Count particles entering each Cr-39 layer and histogram their LET.");
+    fScoreCmd->SetGuidance("Written to cr39_counts.txt and cr39_let.score at the end of each run.");
+    fScoreCmd->SetParameterName("score", false);
+    fScoreCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fScoreCmd->SetToBeBroadcasted(false);
+
+    fLETBinsCmd = new G4UIcommand("/cr39/letBins", this);
+    fLETBinsCmd->SetGuidance("Set the logarithmic LET binning: number of bins, lower and upper edge in keV/um.");
+    G4UIparameter* nbins = new G4UIparameter("nbins", 'i', false);
+    nbins->SetParameterRange("nbins>0");
+    fLETBinsCmd->SetParameter(nbins);
+    G4UIparameter* letMin = new G4UIparameter("letMin", 'd', false);
+    letMin->SetParameterRange("letMin>0.");
+    fLETBinsCmd->SetParameter(letMin);
+    G4UIparameter* letMax = new G4UIparameter("letMax", 'd', false);
+    letMax->SetParameterRange("letMax>0.");
+    fLETBinsCmd->SetParameter(letMax);
+    fLETBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fLETBinsCmd->SetToBeBroadcasted(false);
+}
+
+Cr39ScorerMessenger::~Cr39ScorerMessenger() {
+    delete fDirectory;
+    delete fScoreCmd;
+    delete fLETBinsCmd;
+}
+
+void Cr39ScorerMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fScoreCmd) fScorer->SetEnabled(fScoreCmd->GetNewBoolValue(newValue));
+    if (command == fLETBinsCmd) {
+        std::istringstream iss(newValue);
+        G4int nbins;
+        G4double letMin, letMax;
+        iss >> nbins >> letMin >> letMax;
+        if (letMax <= letMin) {
+            G4Exception("Cr39ScorerMessenger::SetNewValue", "Apollon021", JustWarning,
+                        "LET upper edge must exceed the lower edge; binning unchanged.");
+            return;
+        }
+        fScorer->SetLETBinning(nbins, letMin, letMax);
+    }
+
+}
@@ -0,0 +1,67 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for DenseAccumulator class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstdio>
+#include <cstring>
+
+#include "DenseAccumulator.hh"
+
+#include "G4AutoLock.hh"
+
+namespace {
+    G4Mutex mergeMutex = G4MUTEX_INITIALIZER;
+}
+
+DenseAccumulator::DenseAccumulator() : fSize(0)
+{}
+
+DenseAccumulator::~DenseAccumulator()
+{}
+
+void DenseAccumulator::Resize(std::size_t size) {
+    fSize = size;
+    fTotal.assign(fSize, 0.);
+}
+
+void DenseAccumulator::ResetLocal() {
+    fLocal.Get().assign(fSize, 0.);
+}
+
+void DenseAccumulator::Merge() {
+
+    std::vector<G4double>& local = fLocal.Get();
+    if (local.size() != fSize) return;     // nothing scored on this thread
+
+    G4AutoLock lock(&mergeMutex);
+    for (std::size_t ii = 0; ii < fSize; ++ii) {
+        fTotal[ii] += local[ii];
+    }
+    lock.unlock();
+
+    local.assign(fSize, 0.);
+}
+
+G4bool DenseAccumulator::Write(const G4String& fname, const ScoreFileHeader& header) const {
+
+    std::FILE* outfile = std::fopen(fname.c_str(), "wb");
+    if (!outfile) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open score file " << fname << "; scores of this run are lost.";
+        G4Exception("DenseAccumulator::Write", "Apollon015", JustWarning, msg);
+        return false;
+    }
+
+    ScoreFileHeader theHeader = header;
+    std::memcpy(theHeader.magic, kScoreFileMagic, sizeof(kScoreFileMagic));
+    theHeader.version = kScoreFileVersion;
+    std::fwrite(&theHeader, sizeof(theHeader), 1, outfile);
+    std::fwrite(fTotal.data(), sizeof(G4double), fTotal.size(), outfile);
+    std::fclose(outfile);
+    return true;
+}
@@ -0,0 +1,56 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for DepositHit class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+
+#include "DepositHit.hh"
+
+#include "G4SystemOfUnits.hh"
+
+G4ThreadLocal G4Allocator<DepositHit>* DepositHitAllocator = 0;
+
+DepositHit::DepositHit() : G4VHit(), fDetid(-1), fParticleType(-1), fTrackid(-1), fX(0.f), fY(0.f), fZ(0.f),
+                           fEdep(0.f), fWeight(1.f)
+{}
+
+DepositHit::~DepositHit()
+{}
+
+G4double DepositHit::GetEdep() const { return fEdep*MeV; }
+G4ThreeVector DepositHit::GetPosition() const { return G4ThreeVector(fX*mm, fY*mm, fZ*mm); }
+G4int DepositHit::GetParticleType() const { return fParticleType; }
+G4int DepositHit::GetDetectorID() const { return fDetid; }
+G4int DepositHit::GetTrackID() const { return fTrackid; }
+G4double DepositHit::GetWeight() const { return fWeight; }
+
+void DepositHit::Set(G4int detid, G4int pdg, G4int trackid, const G4ThreeVector& pos, G4double edep,
+                     G4double weight) {
+    fDetid = detid;
+    fParticleType = pdg;
+    fTrackid = trackid;
+    fX = pos.x()/mm;
+    fY = pos.y()/mm;
+    fZ = pos.z()/mm;
+    fEdep = edep/MeV;
+    fWeight = weight;
+}
+
+void DepositHit::Merge(G4int trackid, const G4ThreeVector& pos, G4double edep) {
+    if (trackid != fTrackid) {
+        fParticleType = -1;
+        fTrackid = -1;
+    }
+    G4double sum = fEdep*MeV + edep;
+    if (sum > 0.) {
+        G4double ff = edep/sum;
+        fX += ff*(pos.x()/mm - fX);
+        fY += ff*(pos.y()/mm - fY);
+        fZ += ff*(pos.z()/mm - fZ);
+    }
+    fEdep = sum/MeV;
+}
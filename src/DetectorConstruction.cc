@@ -7,7 +7,9 @@
 
 #include "DetectorConstruction.hh"
 #include "DetectorMessenger.hh"
-#include "SensitiveDetector.hh"
+#include "DetectorSD.hh"
+#include "EventAction.hh"
+#include "DetectorIDTable.hh"
 
 #include "G4NistManager.hh"
 #include "G4Material.hh"
@@ -34,14 +36,17 @@
 //#include "G4GDMLParser.hh"
 
 DetectorConstruction::DetectorConstruction() : G4VUserDetectorConstruction(), fDetectorMessenger(0), 
-                      fLogicChamberMagField(0), fLogicSpecMagField(0), fMagnetStrength(1.*tesla) {
+                      fLogicChamberMagField(0), fLogicSpecMagField(0), fDetectorIDs(0),
+                      fMagnetStrength(1.*tesla), fHitMode(kHitPerStep), fVoxelSize(1.*mm, 1.*mm, 1.*mm) {
 
     DefineMaterials();
+    fDetectorIDs = new DetectorIDTable();
     fDetectorMessenger = new DetectorMessenger(this);
 }
 
-DetectorConstruction::~DetectorConstruction()
-{}
+DetectorConstruction::~DetectorConstruction() {
+    delete fDetectorIDs;
+}
 
 void DetectorConstruction::DefineMaterials() {
     //
@@ -912,7 +917,12 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes() {
 
 G4VPhysicalVolume* DetectorConstruction::Construct() {
 
-    return DefineVolumes();
+    G4VPhysicalVolume* physWorld = DefineVolumes();
+
+    // Detector IDs are looked up by volume from here on
+    fDetectorIDs->Build();
+
+    return physWorld;
     
 }
 
@@ -920,14 +930,24 @@ void DetectorConstruction::ConstructSDandField() {
 
     G4SDManager* SDManager = G4SDManager::GetSDMpointer();
 
-    SensitiveDetector* sd = new SensitiveDetector("sd");
-    SDManager->AddNewDetector(sd);
-    
-    // Setting sensitive volumes
-    SetSensitiveDetector("lYagScreen", sd, true);
-    SetSensitiveDetector("lCr39", sd, true);
-    SetSensitiveDetector("lPhosphorLayer", sd, true);
-    SetSensitiveDetector("lGSpecConverter", sd, true);
+    // One detector per sensitive volume, so that each can be switched
+    // off on its own with /hits/inactivate <name>, or keep its hits but
+    // drop its crossings with /detector/crossings <name> false
+    FullHitSD* yagSD = new FullHitSD("yag", this, kSummaryYag);
+    SDManager->AddNewDetector(yagSD);
+    SetSensitiveDetector("lYagScreen", yagSD, true);
+
+    FullHitSD* cr39SD = new FullHitSD("cr39", this, kSummaryCr39);
+    SDManager->AddNewDetector(cr39SD);
+    SetSensitiveDetector("lCr39", cr39SD, true);
+
+    DepositHitSD* lanexSD = new DepositHitSD("lanex", this, kSummaryLanex);
+    SDManager->AddNewDetector(lanexSD);
+    SetSensitiveDetector("lPhosphorLayer", lanexSD, true);
+
+    DepositHitSD* converterSD = new DepositHitSD("gspec", this, kSummaryGSpec);
+    SDManager->AddNewDetector(converterSD);
+    SetSensitiveDetector("lGSpecConverter", converterSD, true);
 
     // Add magnetic fields
     G4MagneticField* chamberMagField = new G4UniformMagField(G4ThreeVector(0., 1.7*tesla, 0.));
@@ -950,3 +970,29 @@ void DetectorConstruction::SetMagnetStrength(G4double val) {
     G4RunManager::GetRunManager()->ReinitializeGeometry();
 
 }
+
+void DetectorConstruction::SetHitDetectorID(const G4String& name, G4int id) {
+    fDetectorIDs->SetHitID(name, id);
+}
+
+void DetectorConstruction::SetTrackDetectorID(const G4String& name, G4int id) {
+    fDetectorIDs->SetTrackID(name, id);
+}
+
+const DetectorIDTable* DetectorConstruction::GetDetectorIDTable() const {
+    return fDetectorIDs;
+}
+
+void DetectorConstruction::SetHitMode(G4int mode) { fHitMode = mode; }
+void DetectorConstruction::SetVoxelSize(G4ThreeVector size) { fVoxelSize = size; }
+G4int DetectorConstruction::GetHitMode() const { return fHitMode; }
+G4ThreeVector DetectorConstruction::GetVoxelSize() const { return fVoxelSize; }
+
+void DetectorConstruction::SetRecordCrossings(const G4String& name, G4bool record) {
+    if (record) fNoCrossings.erase(name);
+    else fNoCrossings.insert(name);
+}
+
+G4bool DetectorConstruction::GetRecordCrossings(const G4String& name) const {
+    return fNoCrossings.find(name) == fNoCrossings.end();
+}
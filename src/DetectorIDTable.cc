@@ -0,0 +1,92 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for DetectorIDTable class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "DetectorIDTable.hh"
+
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
+
+const G4int DetectorIDTable::kNoDetector;
+
+DetectorIDTable::DetectorIDTable() {
+
+    // Detector IDs of hits (hit and boundary-crossing ntuples)
+    fHitNames["lYagScreen"]      = 1000;
+    fHitNames["lCr39"]           = 2000;
+    fHitNames["lPhosphorLayer"]  = 3000;
+    fHitNames["lGSpecConverter"] = 4000;
+
+    // Detector IDs of track end points (track ntuple)
+    fTrackNames["lYagScreen"]  = 1000;
+    fTrackNames["lStack"]      = 2000;
+    fTrackNames["lLanexSheet"] = 3000;
+}
+
+DetectorIDTable::~DetectorIDTable()
+{}
+
+void DetectorIDTable::SetHitID(const G4String& name, G4int id) {
+    if (id < 0) fHitNames.erase(name);
+    else fHitNames[name] = id;
+    Build();
+}
+
+void DetectorIDTable::SetTrackID(const G4String& name, G4int id) {
+    if (id < 0) fTrackNames.erase(name);
+    else fTrackNames[name] = id;
+    Build();
+}
+
+void DetectorIDTable::Build() {
+    Resolve(fHitNames, fHitIDs);
+    Resolve(fTrackNames, fTrackIDs);
+
+    // Stacks in the order of the volume store, as in Cr39Scorer
+    const G4PhysicalVolumeStore* store = G4PhysicalVolumeStore::GetInstance();
+    fStacks.assign(store->size(), kNoDetector);
+    fStackNames.clear();
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        const G4VPhysicalVolume* volume = (*store)[ii];
+        if (volume->GetLogicalVolume()->GetName() != "lStack") continue;
+
+        std::size_t index = volume->GetInstanceID();
+        if (index >= fStacks.size()) fStacks.resize(index + 1, kNoDetector);
+        fStacks[index] = fStackNames.size();
+        fStackNames.push_back(volume->GetName());
+    }
+}
+
+void DetectorIDTable::Resolve(const std::map<G4String, G4int>& names, std::vector<G4int>& ids) const {
+
+    // Every volume with a configured name is mapped, including copies left
+    // in the store by earlier geometry rebuilds
+    const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+    ids.assign(store->size(), kNoDetector);
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        const G4LogicalVolume* volume = (*store)[ii];
+        std::map<G4String, G4int>::const_iterator it = names.find(volume->GetName());
+        if (it == names.end()) continue;
+
+        std::size_t index = volume->GetInstanceID();
+        if (index >= ids.size()) ids.resize(index + 1, kNoDetector);
+        ids[index] = it->second;
+    }
+}
+
+void DetectorIDTable::Print() const {
+
+    G4cout << "Detector IDs of hits:" << G4endl;
+    for (std::map<G4String, G4int>::const_iterator it = fHitNames.begin(); it != fHitNames.end(); ++it) {
+        G4cout << "    " << it->first << " : " << it->second << G4endl;
+    }
+    G4cout << "Detector IDs of tracks:" << G4endl;
+    for (std::map<G4String, G4int>::const_iterator it = fTrackNames.begin(); it != fTrackNames.end(); ++it) {
+        G4cout << "    " << it->first << " : " << it->second << G4endl;
+    }
+}
@@ -3,15 +3,22 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Source file for DetectorMessenger class
-// Last edited: 13/02/2022
+// Last edited: 17/10/2026
+
+#include <sstream>
 
 #include "DetectorMessenger.hh"
 #include "DetectorConstruction.hh"
+#include "DetectorIDTable.hh"
+#include "SensitiveDetector.hh"
 
 #include "G4UIdirectory.hh"
 #include "G4UIcommand.hh"
 #include "G4UIparameter.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
 
 DetectorMessenger::DetectorMessenger(DetectorConstruction* Det) : G4UImessenger(), fDetector(Det) {
 
@@ -25,6 +32,61 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction* Det) : G4UImessenger(
     fMagnetStrengthCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
     fMagnetStrengthCmd->SetToBeBroadcasted(false);
 
+    fDetDir = new G4UIdirectory("/detector/");
+    fDetDir->SetGuidance("Mapping of logical volumes to the detector IDs written to the output.");
+
+    fHitIDCmd = new G4UIcommand("/detector/hitID", this);
+    fHitIDCmd->SetGuidance("Set the base detector ID of hits in a logical volume (negative removes it).");
+    fHitIDCmd->SetGuidance("Copy numbers are added to the base ID as before.");
+    G4UIparameter* hitVolume = new G4UIparameter("volume", 's', false);
+    fHitIDCmd->SetParameter(hitVolume);
+    G4UIparameter* hitID = new G4UIparameter("id", 'i', false);
+    fHitIDCmd->SetParameter(hitID);
+    fHitIDCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fHitIDCmd->SetToBeBroadcasted(false);
+
+    fTrackIDCmd = new G4UIcommand("/detector/trackID", this);
+    fTrackIDCmd->SetGuidance("Set the base detector ID of tracks ending in a logical volume (negative removes it).");
+    G4UIparameter* trackVolume = new G4UIparameter("volume", 's', false);
+    fTrackIDCmd->SetParameter(trackVolume);
+    G4UIparameter* trackID = new G4UIparameter("id", 'i', false);
+    fTrackIDCmd->SetParameter(trackID);
+    fTrackIDCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fTrackIDCmd->SetToBeBroadcasted(false);
+
+    fPrintIDsCmd = new G4UIcmdWithoutParameter("/detector/printIDs", this);
+    fPrintIDsCmd->SetGuidance("Print the detector ID mapping.");
+    fPrintIDsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPrintIDsCmd->SetToBeBroadcasted(false);
+
+    fHitModeCmd = new G4UIcmdWithAString("/detector/hitMode", this);
+    fHitModeCmd->SetGuidance("Choose how energy deposits in sensitive volumes are written to the Hits tree:");
+    fHitModeCmd->SetGuidance("  step  - one hit per step (default)");
+    fHitModeCmd->SetGuidance("  track - one hit per track and detector");
+    fHitModeCmd->SetGuidance("  voxel - one hit per voxel and detector, holding the weighted energy");
+    fHitModeCmd->SetParameterName("mode", false);
+    fHitModeCmd->SetCandidates("step track voxel");
+    fHitModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fHitModeCmd->SetToBeBroadcasted(false);
+
+    fVoxelSizeCmd = new G4UIcmdWith3VectorAndUnit("/detector/voxelSize", this);
+    fVoxelSizeCmd->SetGuidance("Set the voxel size used by /detector/hitMode voxel.");
+    fVoxelSizeCmd->SetParameterName("dx", "dy", "dz", false);
+    fVoxelSizeCmd->SetRange("dx>0. && dy>0. && dz>0.");
+    fVoxelSizeCmd->SetUnitCategory("Length");
+    fVoxelSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fVoxelSizeCmd->SetToBeBroadcasted(false);
+
+    fCrossingsCmd = new G4UIcommand("/detector/crossings", this);
+    fCrossingsCmd->SetGuidance("Record the boundary crossings of a sensitive detector in the Bdx tree (default true).");
+    fCrossingsCmd->SetGuidance("Its hits are kept either way; /hits/inactivate switches off the whole detector.");
+    G4UIparameter* crossingsDetector = new G4UIparameter("detector", 's', false);
+    crossingsDetector->SetParameterCandidates("yag cr39 lanex gspec");
+    fCrossingsCmd->SetParameter(crossingsDetector);
+    G4UIparameter* crossingsRecord = new G4UIparameter("record", 'b', false);
+    fCrossingsCmd->SetParameter(crossingsRecord);
+    fCrossingsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fCrossingsCmd->SetToBeBroadcasted(false);
 
 }
 
@@ -32,10 +94,40 @@ DetectorMessenger::~DetectorMessenger() {
 
     delete fSpecDir;
     delete fMagnetStrengthCmd;
+    delete fDetDir;
+    delete fHitIDCmd;
+    delete fTrackIDCmd;
+    delete fPrintIDsCmd;
+    delete fHitModeCmd;
+    delete fVoxelSizeCmd;
+    delete fCrossingsCmd;
 
 }
 
 void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
 
     if(command == fMagnetStrengthCmd) fDetector->SetMagnetStrength(fMagnetStrengthCmd->GetNewDoubleValue(newValue));
+
+    if(command == fHitIDCmd || command == fTrackIDCmd) {
+        std::istringstream iss(newValue);
+        G4String volume;
+        G4int id;
+        iss >> volume >> id;
+        if (command == fHitIDCmd) fDetector->SetHitDetectorID(volume, id);
+        else fDetector->SetTrackDetectorID(volume, id);
+    }
+    if(command == fPrintIDsCmd) fDetector->GetDetectorIDTable()->Print();
+
+    if(command == fHitModeCmd) {
+        if (newValue == "step") fDetector->SetHitMode(kHitPerStep);
+        if (newValue == "track") fDetector->SetHitMode(kHitPerTrack);
+        if (newValue == "voxel") fDetector->SetHitMode(kHitPerVoxel);
+    }
+    if(command == fVoxelSizeCmd) fDetector->SetVoxelSize(fVoxelSizeCmd->GetNew3VectorValue(newValue));
+    if(command == fCrossingsCmd) {
+        std::istringstream iss(newValue);
+        G4String name, record;
+        iss >> name >> record;
+        fDetector->SetRecordCrossings(name, G4UIcommand::ConvertToBool(record));
+    }
 }
\ No newline at end of file
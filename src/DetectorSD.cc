@@ -0,0 +1,66 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for DetectorSD class template
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+
+#include "DetectorSD.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4HCofThisEvent.hh"
+
+template<class HitType>
+DetectorSD<HitType>::DetectorSD(G4String name, const DetectorConstruction* detector, G4int summaryDetector) :
+                 SensitiveDetector(name, detector, summaryDetector), fHitCollection(0)
+{}
+
+template<class HitType>
+DetectorSD<HitType>::~DetectorSD()
+{}
+
+template<class HitType>
+void DetectorSD<HitType>::InitializeHits(G4HCofThisEvent* HCE, G4int hcid) {
+    fHitCollection = new G4THitsCollection<HitType>(GetName(), collectionName[0]);
+    fHitCollection->GetVector()->reserve(fHitCapacity);
+    HCE->AddHitsCollection(hcid, fHitCollection);
+}
+
+template<>
+std::size_t DetectorSD<Hit>::AddHit(const G4Step* aStep, G4int detid, const G4ThreeVector& position, G4double edep,
+                                    G4double weight) {
+    return fHitCollection->insert(NewHit(aStep, detid, position, edep, weight)) - 1;
+}
+
+template<>
+std::size_t DetectorSD<DepositHit>::AddHit(const G4Step* aStep, G4int detid, const G4ThreeVector& position,
+                                           G4double edep, G4double weight) {
+
+    const G4Track* track = aStep->GetTrack();
+    DepositHit* aHit = new DepositHit();
+    aHit->Set(detid, track->GetParticleDefinition()->GetPDGEncoding(), track->GetTrackID(), position, edep, weight);
+    return fHitCollection->insert(aHit) - 1;
+}
+
+template<class HitType>
+void DetectorSD<HitType>::MergeHit(std::size_t index, G4int trackid, const G4ThreeVector& position, G4double edep) {
+    (*fHitCollection)[index]->Merge(trackid, position, edep);
+}
+
+template<class HitType>
+std::size_t DetectorSD<HitType>::FillHits(G4int evid) {
+    std::size_t nhits = fHitCollection->entries();
+    if (fEventLayout) {
+        FillHitColumns(*fHitCollection->GetVector());
+        return nhits;
+    }
+    for (std::size_t ii = 0; ii < nhits; ++ii) FillHitRow(evid, (*fHitCollection)[ii]);
+    return nhits;
+}
+
+template class DetectorSD<Hit>;
+template class DetectorSD<DepositHit>;
@@ -0,0 +1,92 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for EnergyLedger class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <fstream>
+
+#include "EnergyLedger.hh"
+#include "OutputManager.hh"
+
+#include "G4LogicalVolumeStore.hh"
+#include "G4SystemOfUnits.hh"
+
+G4ThreadLocal G4double EnergyLedger::fEventEdep = 0.;
+
+EnergyLedger* EnergyLedger::Instance() {
+    static EnergyLedger theLedger;
+    return &theLedger;
+}
+
+EnergyLedger::EnergyLedger()
+{}
+
+EnergyLedger::~EnergyLedger()
+{}
+
+void EnergyLedger::BeginOfRun() {
+
+    // Instance IDs are assigned as the volumes are built
+    const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+    std::size_t nvolumes = 0;
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        std::size_t index = (*store)[ii]->GetInstanceID();
+        if (index + 1 > nvolumes) nvolumes = index + 1;
+    }
+    fLedger.Resize(kNLedgerEntries*nvolumes);
+}
+
+void EnergyLedger::ResetLocal() {
+    fLedger.ResetLocal();
+}
+
+void EnergyLedger::Merge() {
+    fLedger.Merge();
+}
+
+void EnergyLedger::AddKilled(const G4Step* aStep) const {
+    const G4StepPoint* postStepPoint = aStep->GetPostStepPoint();
+    std::size_t index = aStep->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()->GetInstanceID();
+    fLedger.Add(kNLedgerEntries*index + kLedgerKilled, postStepPoint->GetWeight()*postStepPoint->GetKineticEnergy());
+}
+
+void EnergyLedger::Write(G4int nEvents) const {
+
+    const std::vector<G4double>& ledger = fLedger.GetTotal();
+    G4String fname = OutputManager::Instance()->GetRunFileName("energy_ledger.txt");
+    std::ofstream table(fname);
+    table << "# Energy budget per logical volume, weighted and summed over the run (MeV)" << std::endl;
+    table << "# events " << nEvents << std::endl;
+    table << "# volume deposited escaped killed" << std::endl;
+
+    G4double total[kNLedgerEntries] = {0., 0., 0.};
+    const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        const G4LogicalVolume* volume = (*store)[ii];
+        std::size_t first = kNLedgerEntries*volume->GetInstanceID();
+        if (first >= ledger.size()) continue;
+
+        G4bool empty = true;
+        for (G4int kk = 0; kk < kNLedgerEntries; ++kk) {
+            total[kk] += ledger[first + kk];
+            if (ledger[first + kk] != 0.) empty = false;
+        }
+        if (empty) continue;
+
+        table << volume->GetName();
+        for (G4int kk = 0; kk < kNLedgerEntries; ++kk) table << " " << ledger[first + kk]/MeV;
+        table << std::endl;
+    }
+    table << "total";
+    for (G4int kk = 0; kk < kNLedgerEntries; ++kk) table << " " << total[kk]/MeV;
+    table << std::endl;
+    table.close();
+
+    G4cout << "Energy ledger written to " << fname << ": deposited " << total[kLedgerDeposited]/MeV
+           << " MeV, escaped " << total[kLedgerEscaped]/MeV << " MeV, killed " << total[kLedgerKilled]/MeV
+           << " MeV." << G4endl;
+}
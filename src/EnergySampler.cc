@@ -0,0 +1,134 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+//
+// Source file for EnergySampler class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "EnergySampler.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+EnergySampler::EnergySampler()
+{}
+
+EnergySampler::~EnergySampler()
+{}
+
+G4bool EnergySampler::BuildFromFile(const G4String& fname) {
+
+    std::ifstream infile(fname);
+    if (!infile.is_open()) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open spectrum file " << fname << ".";
+        G4Exception("EnergySampler::BuildFromFile", "Apollon001", JustWarning, msg);
+        return false;
+    }
+
+    std::vector<G4double> nodes;
+    std::vector<G4double> density;
+    std::string line;
+    while (std::getline(infile, line)) {
+        std::size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') continue;
+
+        std::istringstream iss(line);
+        G4double energy, value;
+        if (!(iss >> energy >> value)) continue;
+        nodes.push_back(energy*MeV);
+        density.push_back(value);
+    }
+
+    if (!Build(nodes, density)) {
+        G4ExceptionDescription msg;
+        msg << "Spectrum file " << fname << " does not describe a valid spectrum." << G4endl
+            << "Expected at least two lines of increasing energy (MeV) and non-negative intensity.";
+        G4Exception("EnergySampler::BuildFromFile", "Apollon002", JustWarning, msg);
+        return false;
+    }
+    return true;
+}
+
+G4bool EnergySampler::Build(const std::vector<G4double>& nodes, const std::vector<G4double>& density) {
+
+    if (nodes.size() < 2 || nodes.size() != density.size()) return false;
+
+    // Integral of the piecewise-linear spectrum over each bin
+    std::size_t nbins = nodes.size() - 1;
+    std::vector<G4double> weights(nbins);
+    std::vector<G4double> clipped(density);
+    G4double total = 0.;
+    for (std::size_t ii = 0; ii <= nbins; ++ii) {
+        if (clipped[ii] < 0.) clipped[ii] = 0.; // fitted spectra may dip below zero at the edges
+    }
+    for (std::size_t ii = 0; ii < nbins; ++ii) {
+        G4double width = nodes[ii+1] - nodes[ii];
+        if (width <= 0.) return false;
+        weights[ii] = 0.5*(clipped[ii] + clipped[ii+1])*width;
+        total += weights[ii];
+    }
+    if (total <= 0.) return false;
+
+    // Vose's construction of the alias table
+    std::vector<G4double> prob(nbins);
+    std::vector<G4int> alias(nbins);
+    std::vector<G4int> small, large;
+    for (std::size_t ii = 0; ii < nbins; ++ii) {
+        prob[ii] = weights[ii]*nbins/total;
+        alias[ii] = ii;
+        if (prob[ii] < 1.) small.push_back(ii);
+        else large.push_back(ii);
+    }
+    while (!small.empty() && !large.empty()) {
+        G4int ll = small.back(); small.pop_back();
+        G4int gg = large.back(); large.pop_back();
+        alias[ll] = gg;
+        prob[gg] -= 1. - prob[ll];
+        if (prob[gg] < 1.) small.push_back(gg);
+        else large.push_back(gg);
+    }
+    // Leftovers differ from unity only by rounding
+    for (std::size_t ii = 0; ii < small.size(); ++ii) prob[small[ii]] = 1.;
+    for (std::size_t ii = 0; ii < large.size(); ++ii) prob[large[ii]] = 1.;
+
+    fNodes = nodes;
+    fDensity = clipped;
+    fProb = prob;
+    fAlias = alias;
+    return true;
+}
+
+G4double EnergySampler::Sample() const {
+    G4double u1 = G4UniformRand();
+    G4double u2 = G4UniformRand();
+    return Sample(u1, u2);
+}
+
+G4double EnergySampler::Sample(G4double u1, G4double u2) const {
+
+    // Choose a bin: one uniform number gives both the bin and the alias test
+    G4int nbins = fProb.size();
+    G4double xx = u1*nbins;
+    G4int bin = static_cast<G4int>(xx);
+    if (bin >= nbins) bin = nbins - 1;
+    if (xx - bin >= fProb[bin]) bin = fAlias[bin];
+
+    // Invert the linear density across the bin
+    G4double aa = fDensity[bin];
+    G4double bb = fDensity[bin+1];
+    G4double denom = aa + std::sqrt(aa*aa + u2*(bb*bb - aa*aa));
+    G4double tt = (denom > 0.) ? u2*(aa + bb)/denom : u2;
+
+    return fNodes[bin] + tt*(fNodes[bin+1] - fNodes[bin]);
+}
+
+G4double EnergySampler::GetEnergyMin() const { return fNodes.front(); }
+G4double EnergySampler::GetEnergyMax() const { return fNodes.back(); }
+G4int EnergySampler::GetNumberOfBins() const { return fProb.size(); }
@@ -3,43 +3,168 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Source file for EventAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "SeedStore.hh"
+#include "EnergyLedger.hh"
+#include "MuonTruthStore.hh"
+#include "ConvergenceMonitor.hh"
+#include "TallyAccumulable.hh"
+#include "OutputManager.hh"
+#include "OutputBatch.hh"
+#include "DetectorConstruction.hh"
+#include "DetectorIDTable.hh"
 
 #include "G4SystemOfUnits.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4VAnalysisManager.hh"
 #include "G4RunManager.hh"
-#include "G4RootAnalysisManager.hh"
 
-EventAction::EventAction(RunAction*) : G4UserEventAction(), fEdep(0.)
+namespace {
+    const char* detectorNames[kNSummaryDetectors] = {"yag", "cr39", "lanex", "gspec"};
+    const char* speciesNames[kNSummarySpecies] = {"mu", "e", "p", "other"};
+    // evid, edep and weight come first
+    const G4int firstSummaryColumn = 3;
+    const G4int columnsPerDetector = 2 + kNSummarySpecies;
+
+    // Detector construction is shared with the master
+    const DetectorIDTable* GetDetectorIDs() {
+        const DetectorConstruction* detector =
+            static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+        return detector->GetDetectorIDTable();
+    }
+}
+
+EventAction::EventAction(RunAction* runAction) : G4UserEventAction(), fRunAction(runAction), fEventID(0), fFlags(0)
 {}
 
 EventAction::~EventAction()
 {}
 
-void EventAction::BeginOfEventAction(const G4Event*)
-{}
+void EventAction::BeginOfEventAction(const G4Event* anEvent) {
+    fEventID = anEvent->GetEventID();
+    EnergyLedger::Instance()->ResetEvent();
+    if (MuonTruthStore::Instance()->IsEnabled()) MuonTruthStore::Instance()->BeginEvent();
 
-void EventAction::EndOfEventAction(const G4Event*) {
+    // Track IDs start at 1
+    G4int ngroups = GetNumberOfSummaryGroups();
+    fGroupEdep.assign(ngroups, 0.);
+    fGroupSteps.assign(ngroups, 0);
+    fGroupLastTrack.assign(ngroups, 0);
+    fSpeciesTracks.assign(ngroups*kNSummarySpecies, 0);
+}
 
-    G4RootAnalysisManager* analysisManager = G4RootAnalysisManager::Instance();
-    G4RunManager* runManager = G4RunManager::GetRunManager();
+void EventAction::CreateSummaryColumns(G4int ntupleId) {
 
-    analysisManager->FillNtupleIColumn(1, 0, runManager->GetCurrentEvent()->GetEventID());
-    analysisManager->FillNtupleDColumn(1, 1, fEdep/MeV);
-    analysisManager->AddNtupleRow(1);
+    G4VAnalysisManager* analysisManager = OutputManager::Instance()->GetAnalysisManager();
+    for (G4int gg = 0; gg < GetNumberOfSummaryGroups(); ++gg) {
+        G4String prefix = GetSummaryGroupName(gg);
+        analysisManager->CreateNtupleDColumn(ntupleId, prefix + "_edep");
+        analysisManager->CreateNtupleIColumn(ntupleId, prefix + "_nsteps");
+        for (G4int ss = 0; ss < kNSummarySpecies; ++ss) {
+            analysisManager->CreateNtupleIColumn(ntupleId, prefix + "_n" + speciesNames[ss]);
+        }
+    }
+}
 
-    fEdep = 0.;
-    return;
+G4int EventAction::FindColumn(const G4String& name) {
+
+    if (name == "edep") return 1;
+    if (name == "weight") return 2;
+    for (G4int gg = 0; gg < GetNumberOfSummaryGroups(); ++gg) {
+        G4String prefix = GetSummaryGroupName(gg);
+        G4int column = firstSummaryColumn + gg*columnsPerDetector;
+        if (name == prefix + "_edep") return column;
+        if (name == prefix + "_nsteps") return column + 1;
+        for (G4int ss = 0; ss < kNSummarySpecies; ++ss) {
+            if (name == prefix + "_n" + speciesNames[ss]) return column + 2 + ss;
+        }
+    }
+    return -1;
+}
+
+G4String EventAction::GetDetectorName(G4int detector) {
+    return detectorNames[detector];
+}
+
+G4int EventAction::GetNumberOfSummaryGroups() {
+    return kNSummaryDetectors + GetDetectorIDs()->GetNumberOfStacks();
+}
+
+G4String EventAction::GetSummaryGroupName(G4int group) {
+    if (group < kNSummaryDetectors) return detectorNames[group];
+    return G4String(detectorNames[kSummaryCr39]) + "_" + GetDetectorIDs()->GetStackName(group - kNSummaryDetectors);
 }
 
-void EventAction::AddEdep(G4double edep) {
-    fEdep += edep;
+G4double EventAction::GetColumnValue(G4int column, G4double weight) const {
+
+    if (column == 1) return EnergyLedger::Instance()->GetEventEdep()/MeV;
+    if (column == 2) return weight;
+
+    G4int gg = (column - firstSummaryColumn)/columnsPerDetector;
+    G4int kk = (column - firstSummaryColumn)%columnsPerDetector;
+    if (kk == 0) return fGroupEdep[gg]/MeV;
+    if (kk == 1) return fGroupSteps[gg];
+    return fSpeciesTracks[gg*kNSummarySpecies + kk - 2];
+}
+
+void EventAction::EndOfEventAction(const G4Event* anEvent) {
+
+    OutputBatch* batch = OutputManager::Instance()->GetBatch();
+
+    // Event weight is the summed weight of its primaries
+    G4double weight = 0.;
+    for (G4int ii = 0; ii < anEvent->GetNumberOfPrimaryVertex(); ++ii) {
+        weight += anEvent->GetPrimaryVertex(ii)->GetPrimary()->GetWeight();
+    }
+
+    batch->FillNtupleIColumn(1, 0, fEventID);
+    batch->FillNtupleDColumn(1, 1, EnergyLedger::Instance()->GetEventEdep()/MeV);
+    batch->FillNtupleDColumn(1, 2, weight);
+    for (std::size_t gg = 0; gg < fGroupEdep.size(); ++gg) {
+        G4int column = firstSummaryColumn + gg*columnsPerDetector;
+        batch->FillNtupleDColumn(1, column, fGroupEdep[gg]/MeV);
+        batch->FillNtupleIColumn(1, column + 1, fGroupSteps[gg]);
+        for (G4int ss = 0; ss < kNSummarySpecies; ++ss) {
+            batch->FillNtupleIColumn(1, column + 2 + ss, fSpeciesTracks[gg*kNSummarySpecies + ss]);
+        }
+    }
+    batch->AddNtupleRow(1);
+
+    // Event layout: the hits, tracks and crossings are already in the vectors
+    if (OutputManager::Instance()->IsEventLayout()) {
+        const G4int vectorNtuples[3] = {0, 2, 4};
+        for (G4int ii = 0; ii < 3; ++ii) {
+            batch->FillNtupleIColumn(vectorNtuples[ii], 0, fEventID);
+            batch->AddNtupleRow(vectorNtuples[ii]);
+        }
+    }
+
+    // Tallies followed by the convergence monitor
+    ConvergenceMonitor* monitor = ConvergenceMonitor::Instance();
+    if (monitor->GetNumberOfTallies() > 0) {
+        fTallyValues.resize(monitor->GetNumberOfTallies());
+        for (std::size_t ii = 0; ii < fTallyValues.size(); ++ii) {
+            fTallyValues[ii] = GetColumnValue(monitor->GetTallyColumn(ii), weight);
+        }
+        fRunAction->GetTallies().Fill(fTallyValues);
+        monitor->EndEvent(fTallyValues);
+    }
+
+    SeedStore::Instance()->EndEvent(anEvent->GetEventID(), fFlags);
+    if (MuonTruthStore::Instance()->IsEnabled()) MuonTruthStore::Instance()->EndEvent(anEvent->GetEventID());
+
+    // All rows of the event are in the batch by now
+    OutputManager::Instance()->EndEvent(fEventID);
+
+    fFlags = 0;
     return;
 }
 
-G4double EventAction::GetEdep() const {
-    return fEdep;
-}
\ No newline at end of file
+void EventAction::AddFlag(G4int flag) {
+    fFlags |= flag;
+}
@@ -3,34 +3,57 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Source file for Hit class
+// Last edited: 17/10/2026
 //
 
 #include "Hit.hh"
 
-#include "G4ThreeVector.hh"
+#include "G4SystemOfUnits.hh"
 
-Hit::Hit() : G4VHit(), fEdep(0.), fEnergy(0.), fPosition(0), fVertexPosition(0),
-             fParticleType(-1), fProcess(-1), fDetid(-1)
+G4ThreadLocal G4Allocator<Hit>* HitAllocator = 0;
+
+Hit::Hit() : G4VHit(), fParticleType(-1), fProcess(-1), fDetid(-1), fTrackid(-1),
+             fX(0.f), fY(0.f), fZ(0.f), fVtxX(0.f), fVtxY(0.f), fVtxZ(0.f),
+             fEdep(0.f), fEnergy(0.f), fWeight(1.f)
 {}
 
 Hit::~Hit()
 {}
 
-G4double Hit::GetEdep() const { return fEdep; }
-G4double Hit::GetEnergy() const { return fEnergy; }
-G4ThreeVector Hit::GetPosition() const { return fPosition; }
-G4ThreeVector Hit::GetVertexPosition() const { return fVertexPosition; }
+G4double Hit::GetEdep() const { return fEdep*MeV; }
+G4double Hit::GetEnergy() const { return fEnergy*MeV; }
+G4ThreeVector Hit::GetPosition() const { return G4ThreeVector(fX*mm, fY*mm, fZ*mm); }
+G4ThreeVector Hit::GetVertexPosition() const { return G4ThreeVector(fVtxX*mm, fVtxY*mm, fVtxZ*mm); }
 G4int Hit::GetParticleType() const { return fParticleType; }
 G4int Hit::GetProcess() const { return fProcess; }
 G4int Hit::GetDetectorID() const { return fDetid; }
 G4int Hit::GetTrackID() const { return fTrackid; }
+G4double Hit::GetWeight() const { return fWeight; }
 
 
-void Hit::AddEdep(G4double edep) { fEdep = edep; }
-void Hit::AddEnergy(G4double eneg) { fEnergy = eneg; }
-void Hit::AddPosition(G4ThreeVector pos) { fPosition = pos; }
-void Hit::AddVertexPosition(G4ThreeVector vpos) { fVertexPosition = vpos; }
+void Hit::AddEdep(G4double edep) { fEdep = edep/MeV; }
+void Hit::AddEnergy(G4double eneg) { fEnergy = eneg/MeV; }
+void Hit::AddPosition(G4ThreeVector pos) { fX = pos.x()/mm; fY = pos.y()/mm; fZ = pos.z()/mm; }
+void Hit::AddVertexPosition(G4ThreeVector vpos) { fVtxX = vpos.x()/mm; fVtxY = vpos.y()/mm; fVtxZ = vpos.z()/mm; }
 void Hit::AddParticleType(G4int pdg) { fParticleType = pdg;  }
 void Hit::AddProcess(G4int procid) { fProcess = procid; }
 void Hit::AddDetectorID(G4int detid) { fDetid = detid; }
-void Hit::AddTrackID(G4int trackid) { fTrackid = trackid; }
\ No newline at end of file
+void Hit::AddTrackID(G4int trackid) { fTrackid = trackid; }
+void Hit::AddWeight(G4double weight) { fWeight = weight; }
+void Hit::Merge(G4int trackid, G4ThreeVector pos, G4double edep) {
+    if (trackid != fTrackid) {
+        fParticleType = -1;
+        fProcess = -1;
+        fTrackid = -1;
+        fVtxX = fVtxY = fVtxZ = 0.f;
+        fEnergy = 0.f;
+    }
+    G4double sum = fEdep*MeV + edep;
+    if (sum > 0.) {
+        G4double ff = edep/sum;
+        fX += ff*(pos.x()/mm - fX);
+        fY += ff*(pos.y()/mm - fY);
+        fZ += ff*(pos.z()/mm - fZ);
+    }
+    fEdep = sum/MeV;
+}
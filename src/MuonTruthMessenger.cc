@@ -0,0 +1,55 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for MuonTruthMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "MuonTruthMessenger.hh"
+#include "MuonTruthStore.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+MuonTruthMessenger::MuonTruthMessenger(MuonTruthStore* store) : G4UImessenger(), fStore(store) {
+
+    fDirectory = new G4UIdirectory("/muons/");
+    fDirectory->SetGuidance("Production history and plane crossings of muons.");
+
+    fTruthCmd = new G4UIcmdWithABool("/muons/truth", this);
+    fTruthCmd->SetGuidance("Write the ancestry of every muon to the MuonTruth tree, and its plane crossings to MuonPlanes.");
+    fTruthCmd->SetParameterName("truth", false);
+    fTruthCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fTruthCmd->SetToBeBroadcasted(false);
+
+    fPlaneCmd = new G4UIcmdWithADoubleAndUnit("/muons/plane", this);
+    fPlaneCmd->SetGuidance("Add a plane at the given z where muon crossings are recorded.");
+    fPlaneCmd->SetParameterName("z", false);
+    fPlaneCmd->SetUnitCategory("Length");
+    fPlaneCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPlaneCmd->SetToBeBroadcasted(false);
+
+    fClearPlanesCmd = new G4UIcmdWithoutParameter("/muons/clearPlanes", this);
+    fClearPlanesCmd->SetGuidance("Remove all crossing planes.");
+    fClearPlanesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fClearPlanesCmd->SetToBeBroadcasted(false);
+}
+
+MuonTruthMessenger::~MuonTruthMessenger() {
+    delete fDirectory;
+    delete fTruthCmd;
+    delete fPlaneCmd;
+    delete fClearPlanesCmd;
+}
+
+void MuonTruthMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fTruthCmd) fStore->SetEnabled(fTruthCmd->GetNewBoolValue(newValue));
+    if (command == fPlaneCmd) fStore->AddPlane(fPlaneCmd->GetNewDoubleValue(newValue));
+    if (command == fClearPlanesCmd) fStore->ClearPlanes();
+
+}
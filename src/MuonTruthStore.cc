@@ -0,0 +1,196 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for MuonTruthStore class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <algorithm>
+#include <cstdlib>
+
+#include "MuonTruthStore.hh"
+#include "MuonTruthMessenger.hh"
+#include "ProcessRegistry.hh"
+#include "OutputManager.hh"
+#include "OutputBatch.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4LogicalVolume.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace {
+    // MuonTruth and MuonPlanes ntuples, created by RunAction
+    const G4int truthNtuple = 6;
+    const G4int planeNtuple = 7;
+
+    // One entry per track of the event, at index trackID
+    struct TruthTrack {
+        G4int parentID;
+        G4int pdg;
+        G4int procid;
+        const G4LogicalVolume* volume;  // volume at the production vertex
+        G4float x, y, z;                // vertex, mm
+        G4float energy;                 // kinetic energy at the vertex, MeV
+        G4float weight;
+        G4bool keep;
+    };
+
+    struct PlaneCrossing {
+        G4int trackID;
+        G4int plane;
+        G4float x, y;                   // mm
+        G4float px, py, pz;             // MeV/c
+        G4float energy;                 // kinetic, MeV
+    };
+
+    struct TruthEvent {
+        std::vector<TruthTrack> tracks;
+        std::vector<G4int> muons;
+        std::vector<PlaneCrossing> crossings;
+    };
+    G4ThreadLocal TruthEvent* truthEvent = 0;
+
+    TruthEvent* GetTruthEvent() {
+        if (!truthEvent) truthEvent = new TruthEvent();
+        return truthEvent;
+    }
+}
+
+MuonTruthStore* MuonTruthStore::Instance() {
+    static MuonTruthStore theStore;
+    return &theStore;
+}
+
+MuonTruthStore::MuonTruthStore() : fMessenger(0), fEnabled(false) {
+    fMessenger = new MuonTruthMessenger(this);
+}
+
+MuonTruthStore::~MuonTruthStore() {
+    delete fMessenger;
+}
+
+void MuonTruthStore::BeginEvent() const {
+
+    // Storage is kept from event to event
+    TruthEvent* event = GetTruthEvent();
+    event->tracks.clear();
+    event->muons.clear();
+    event->crossings.clear();
+}
+
+void MuonTruthStore::AddTrack(const G4Track* track) const {
+
+    TruthEvent* event = GetTruthEvent();
+    std::size_t trackID = track->GetTrackID();
+    if (trackID >= event->tracks.size()) event->tracks.resize(trackID + 1);
+
+    const G4ThreeVector& vertex = track->GetVertexPosition();
+    TruthTrack& entry = event->tracks[trackID];
+    entry.parentID = track->GetParentID();
+    entry.pdg = track->GetParticleDefinition()->GetPDGEncoding();
+    entry.procid = ProcessRegistry::GetCreatorID(track);
+    entry.volume = track->GetLogicalVolumeAtVertex();
+    entry.x = vertex.x()/mm;
+    entry.y = vertex.y()/mm;
+    entry.z = vertex.z()/mm;
+    entry.energy = track->GetVertexKineticEnergy()/MeV;
+    entry.weight = track->GetWeight();
+    entry.keep = false;
+
+    if (std::abs(entry.pdg) == 13) event->muons.push_back(trackID);
+}
+
+void MuonTruthStore::Score(const G4Step* aStep) const {
+
+    if (fPlanes.empty()) return;
+    const G4Track* track = aStep->GetTrack();
+    if (std::abs(track->GetParticleDefinition()->GetPDGEncoding()) != 13) return;
+
+    // Crossings in either direction, interpolated linearly along the step
+    const G4StepPoint* preStepPoint = aStep->GetPreStepPoint();
+    const G4ThreeVector& prePosition = preStepPoint->GetPosition();
+    const G4ThreeVector& postPosition = aStep->GetPostStepPoint()->GetPosition();
+    G4double zlow = std::min(prePosition.z(), postPosition.z());
+    G4double zhigh = std::max(prePosition.z(), postPosition.z());
+    for (std::size_t ii = 0; ii < fPlanes.size(); ++ii) {
+        if (fPlanes[ii] < zlow || fPlanes[ii] >= zhigh) continue;
+
+        G4double ff = (fPlanes[ii] - prePosition.z())/(postPosition.z() - prePosition.z());
+        G4ThreeVector position = prePosition + ff*(postPosition - prePosition);
+        G4ThreeVector momentum = preStepPoint->GetMomentum();
+
+        PlaneCrossing crossing;
+        crossing.trackID = track->GetTrackID();
+        crossing.plane = ii;
+        crossing.x = position.x()/mm;
+        crossing.y = position.y()/mm;
+        crossing.px = momentum.x()/MeV;
+        crossing.py = momentum.y()/MeV;
+        crossing.pz = momentum.z()/MeV;
+        crossing.energy = preStepPoint->GetKineticEnergy()/MeV;
+        GetTruthEvent()->crossings.push_back(crossing);
+    }
+}
+
+void MuonTruthStore::EndEvent(G4int evid) const {
+
+    TruthEvent* event = GetTruthEvent();
+    if (event->muons.empty()) return;
+
+    // Marks each muon and its ancestors up to the primary; a chain stops
+    // early where it joins one already marked
+    for (std::size_t ii = 0; ii < event->muons.size(); ++ii) {
+        G4int trackID = event->muons[ii];
+        while (trackID > 0 && static_cast<std::size_t>(trackID) < event->tracks.size()
+               && !event->tracks[trackID].keep) {
+            event->tracks[trackID].keep = true;
+            trackID = event->tracks[trackID].parentID;
+        }
+    }
+
+    OutputBatch* batch = OutputManager::Instance()->GetBatch();
+    for (std::size_t trackID = 1; trackID < event->tracks.size(); ++trackID) {
+        const TruthTrack& entry = event->tracks[trackID];
+        if (!entry.keep) continue;
+
+        batch->FillNtupleIColumn(truthNtuple, 0, evid);
+        batch->FillNtupleIColumn(truthNtuple, 1, trackID);
+        batch->FillNtupleIColumn(truthNtuple, 2, entry.parentID);
+        batch->FillNtupleIColumn(truthNtuple, 3, entry.pdg);
+        batch->FillNtupleIColumn(truthNtuple, 4, entry.procid);
+        batch->FillNtupleSColumn(truthNtuple, 5, entry.volume ? entry.volume->GetName() : G4String(""));
+        batch->FillNtupleDColumn(truthNtuple, 6, entry.x);
+        batch->FillNtupleDColumn(truthNtuple, 7, entry.y);
+        batch->FillNtupleDColumn(truthNtuple, 8, entry.z);
+        batch->FillNtupleDColumn(truthNtuple, 9, entry.energy);
+        batch->FillNtupleDColumn(truthNtuple, 10, entry.weight);
+        batch->AddNtupleRow(truthNtuple);
+    }
+
+    for (std::size_t ii = 0; ii < event->crossings.size(); ++ii) {
+        const PlaneCrossing& crossing = event->crossings[ii];
+
+        batch->FillNtupleIColumn(planeNtuple, 0, evid);
+        batch->FillNtupleIColumn(planeNtuple, 1, crossing.trackID);
+        batch->FillNtupleIColumn(planeNtuple, 2, crossing.plane);
+        batch->FillNtupleDColumn(planeNtuple, 3, crossing.x);
+        batch->FillNtupleDColumn(planeNtuple, 4, crossing.y);
+        batch->FillNtupleDColumn(planeNtuple, 5, fPlanes[crossing.plane]/mm);
+        batch->FillNtupleDColumn(planeNtuple, 6, crossing.px);
+        batch->FillNtupleDColumn(planeNtuple, 7, crossing.py);
+        batch->FillNtupleDColumn(planeNtuple, 8, crossing.pz);
+        batch->FillNtupleDColumn(planeNtuple, 9, crossing.energy);
+        batch->AddNtupleRow(planeNtuple);
+    }
+}
+
+void MuonTruthStore::SetEnabled(G4bool val) { fEnabled = val; }
+
+void MuonTruthStore::AddPlane(G4double zz) { fPlanes.push_back(zz); }
+
+void MuonTruthStore::ClearPlanes() { fPlanes.clear(); }
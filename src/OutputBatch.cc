@@ -0,0 +1,93 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for OutputBatch class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "OutputBatch.hh"
+#include "ColumnFormat.hh"
+#include "VectorColumns.hh"
+
+OutputBatch::OutputBatch() : fEventID(0), fMode(kRecord), fAnalysisManager(0), fFormats(0), fVectors(0)
+{}
+
+OutputBatch::~OutputBatch()
+{}
+
+void OutputBatch::PassFills(G4VAnalysisManager* analysisManager, const ColumnFormatTable* formats,
+                            VectorColumns* vectors) {
+    fMode = kPass;
+    fAnalysisManager = analysisManager;
+    fFormats = formats;
+    fVectors = vectors;
+}
+
+void OutputBatch::DropFills() {
+    fMode = kDrop;
+    fAnalysisManager = 0;
+    fFormats = 0;
+    fVectors = 0;
+}
+
+void OutputBatch::PassDouble(G4int ntuple, G4int column, G4double value) const {
+    FillDouble(fAnalysisManager, *fFormats, ntuple, column, value);
+}
+
+void OutputBatch::PassRow(G4int ntuple) {
+    // Vector values of the row are still appended to the batch
+    if (fVectors) fVectors->Load(ntuple, *this);
+    fAnalysisManager->AddNtupleRow(ntuple);
+}
+
+void OutputBatch::FillDouble(G4VAnalysisManager* analysisManager, const ColumnFormatTable& formats, G4int ntuple,
+                             G4int column, G4double value) {
+
+    const ColumnFormat& format = formats.Get(ntuple, column);
+    if (format.storage == kStoreFloat) {
+        analysisManager->FillNtupleFColumn(ntuple, column, static_cast<G4float>(value));
+    }
+    else if (format.storage == kStoreFixed) {
+        analysisManager->FillNtupleIColumn(ntuple, column, format.Quantize(value));
+    }
+    else {
+        analysisManager->FillNtupleDColumn(ntuple, column, value);
+    }
+}
+
+void OutputBatch::Replay(G4VAnalysisManager* analysisManager, const ColumnFormatTable& formats,
+                         VectorColumns* vectors) const {
+
+    for (std::size_t ii = 0; ii < fOps.size(); ++ii) {
+        const Op& op = fOps[ii];
+        switch (op.type) {
+            case kFillInt:
+                analysisManager->FillNtupleIColumn(op.ntuple, op.column, op.ival);
+                break;
+            case kFillDouble:
+                FillDouble(analysisManager, formats, op.ntuple, op.column, op.dval);
+                break;
+            case kFillString:
+                analysisManager->FillNtupleSColumn(op.ntuple, op.column, fStrings[op.ival]);
+                break;
+            case kAddRow:
+                if (vectors) vectors->Load(op.ntuple, *this);
+                analysisManager->AddNtupleRow(op.ntuple);
+                break;
+        }
+    }
+}
+
+void OutputBatch::Clear() {
+    // Capacity is kept for the next event
+    fOps.clear();
+    fStrings.clear();
+    for (std::size_t ii = 0; ii < fIVectors.size(); ++ii) {
+        for (std::size_t jj = 0; jj < fIVectors[ii].size(); ++jj) fIVectors[ii][jj].clear();
+    }
+    for (std::size_t ii = 0; ii < fDVectors.size(); ++ii) {
+        for (std::size_t jj = 0; jj < fDVectors[ii].size(); ++jj) fDVectors[ii][jj].clear();
+    }
+}
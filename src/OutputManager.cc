@@ -0,0 +1,562 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for OutputManager class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <atomic>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "OutputManager.hh"
+#include "OutputMessenger.hh"
+#include "OutputBatch.hh"
+#include "VectorColumns.hh"
+
+#include "G4Threading.hh"
+#include "G4AutoLock.hh"
+#include "G4MTRunManager.hh"
+#include "G4Version.hh"
+#include "Randomize.hh"
+
+#if G4VERSION_NUMBER >= 1100
+#include "G4GenericAnalysisManager.hh"
+#else
+#include "G4RootAnalysisManager.hh"
+#include "G4CsvAnalysisManager.hh"
+#endif
+
+namespace {
+    // Single-producer single-consumer ring of batches; one slot is left
+    // empty to tell a full ring from an empty one
+    class BatchRing {
+        public:
+            explicit BatchRing(std::size_t capacity) : fSlots(capacity + 1), fHead(0), fTail(0) {}
+
+            G4bool Push(OutputBatch* batch) {
+                std::size_t tail = fTail.load(std::memory_order_relaxed);
+                std::size_t next = (tail + 1)%fSlots.size();
+                if (next == fHead.load(std::memory_order_acquire)) return false;
+                fSlots[tail] = batch;
+                fTail.store(next, std::memory_order_release);
+                return true;
+            }
+
+            OutputBatch* Peek() const {
+                std::size_t head = fHead.load(std::memory_order_relaxed);
+                if (head == fTail.load(std::memory_order_acquire)) return 0;
+                return fSlots[head];
+            }
+
+            OutputBatch* Pop() {
+                std::size_t head = fHead.load(std::memory_order_relaxed);
+                if (head == fTail.load(std::memory_order_acquire)) return 0;
+                OutputBatch* batch = fSlots[head];
+                fHead.store((head + 1)%fSlots.size(), std::memory_order_release);
+                return batch;
+            }
+
+        private:
+            std::vector<OutputBatch*> fSlots;
+            std::atomic<std::size_t> fHead;     // next slot to pop, written by the consumer
+            std::atomic<std::size_t> fTail;     // next slot to push, written by the producer
+    };
+
+    // Wakes a thread sleeping until a ring it reads from changes. The
+    // rings are lock-free; the mutex only keeps a notification from
+    // falling between the sleeper's last look and its wait.
+    struct WakeUp {
+        void Notify() {
+            {
+                G4AutoLock lock(&mutex);
+            }
+            condition.notify_all();
+        }
+
+        G4Mutex mutex;
+        G4Condition condition;
+    };
+
+    // Batches go to the writer full and come back empty, so both rings
+    // can hold every batch and a push never fails
+    struct WriterPipeline {
+        WriterPipeline(G4VAnalysisManager* manager, VectorColumns* columns, std::size_t nbatches,
+                       WakeUp* writerWake) :
+            analysisManager(manager), vectors(columns), batches(nbatches), filled(nbatches), empty(nbatches),
+            done(false), filledWake(writerWake ? writerWake : &ownWake) {
+            for (std::size_t ii = 0; ii < nbatches; ++ii) {
+                batches[ii] = new OutputBatch();
+                empty.Push(batches[ii]);
+            }
+        }
+        ~WriterPipeline() {
+            for (std::size_t ii = 0; ii < batches.size(); ++ii) delete batches[ii];
+        }
+
+        G4VAnalysisManager* analysisManager;    // used only by the writer while the run is going; null when merged
+        VectorColumns* vectors;                 // the worker's, likewise
+        std::vector<OutputBatch*> batches;
+        BatchRing filled;                       // worker to writer
+        BatchRing empty;                        // writer back to worker
+        std::atomic<bool> done;
+        WakeUp ownWake;
+        WakeUp* filledWake;                     // writer waiting for filled or done: its own, or the merger's
+        WakeUp emptyWake;                       // worker waiting for an empty batch
+        std::thread writer;
+    };
+
+    // Merged output: each worker streams its batches to the master's
+    // writer, which always writes the lowest event ID waiting. A worker
+    // sees its events in increasing order, so that batch can be written
+    // once every stream still running has one waiting. Nothing is written
+    // before every worker thread has joined, as the lowest event ID may be
+    // in a stream that has not joined yet.
+    struct EventMerger {
+        EventMerger(G4VAnalysisManager* manager, VectorColumns* columns, std::size_t nworkers) :
+            analysisManager(manager), vectors(columns), nstreams(nworkers), closed(false) {}
+        ~EventMerger() {
+            for (std::size_t ii = 0; ii < streams.size(); ++ii) delete streams[ii];
+        }
+
+        G4VAnalysisManager* analysisManager;    // the master's
+        VectorColumns* vectors;                 // the master's
+        std::size_t nstreams;                   // worker threads of the run
+        std::vector<WriterPipeline*> streams;   // one per worker, guarded by wake.mutex while they join
+        std::atomic<bool> closed;               // set once every worker has ended its run
+        WakeUp wake;                            // any stream joined, filled or done, or closed
+        std::thread writer;
+    };
+
+    EventMerger* merger = 0;
+
+    G4ThreadLocal G4VAnalysisManager* threadAnalysisManager = 0;
+    G4ThreadLocal VectorColumns* threadVectors = 0;
+    G4ThreadLocal G4bool threadFileOpen = false;
+    G4ThreadLocal G4bool threadMerging = false;
+    G4ThreadLocal OutputBatch* currentBatch = 0;
+    G4ThreadLocal WriterPipeline* pipeline = 0;
+
+    // The writer drives the worker's thread-local analysis manager from
+    // another thread. The worker makes no call on it while the writer
+    // runs: every row goes through a batch, the ntuples are booked and the
+    // Formats rows filled before the writer starts (RunAction), and
+    // EndOfRun joins the writer before the worker writes and closes the file.
+    void RunWriter(WriterPipeline* pipe) {
+        for (;;) {
+            OutputBatch* batch = 0;
+            {
+                G4AutoLock lock(&pipe->filledWake->mutex);
+                for (;;) {
+                    // Read before popping: once done is seen every batch has been pushed
+                    G4bool done = pipe->done.load(std::memory_order_acquire);
+                    batch = pipe->filled.Pop();
+                    if (batch || done) break;
+                    pipe->filledWake->condition.wait(lock);
+                }
+            }
+            if (!batch) break;
+
+            batch->Replay(pipe->analysisManager, OutputManager::Instance()->GetColumnFormats(), pipe->vectors);
+            batch->Clear();
+            pipe->empty.Push(batch);
+            pipe->emptyWake.Notify();
+        }
+    }
+
+    void RunMerger(EventMerger* merge) {
+
+        // The streams are fixed once every worker has joined
+        std::vector<WriterPipeline*> streams;
+        {
+            G4AutoLock lock(&merge->wake.mutex);
+            while (merge->streams.size() < merge->nstreams && !merge->closed.load(std::memory_order_acquire)) {
+                merge->wake.condition.wait(lock);
+            }
+            streams = merge->streams;
+        }
+
+        for (;;) {
+            WriterPipeline* from = 0;
+            OutputBatch* next = 0;
+            {
+                G4AutoLock lock(&merge->wake.mutex);
+                for (;;) {
+                    G4bool closed = merge->closed.load(std::memory_order_acquire);
+                    G4bool waiting = false;
+                    from = 0;
+                    next = 0;
+                    for (std::size_t ii = 0; ii < streams.size(); ++ii) {
+                        G4bool done = closed || streams[ii]->done.load(std::memory_order_acquire);
+                        OutputBatch* head = streams[ii]->filled.Peek();
+                        if (!head) {
+                            if (!done) waiting = true;
+                            continue;
+                        }
+                        if (!next || head->GetEventID() < next->GetEventID()) {
+                            next = head;
+                            from = streams[ii];
+                        }
+                    }
+                    if (next ? !waiting : closed) break;
+                    merge->wake.condition.wait(lock);
+                }
+            }
+            if (!next) break;
+
+            from->filled.Pop();
+            next->Replay(merge->analysisManager, OutputManager::Instance()->GetColumnFormats(), merge->vectors);
+            next->Clear();
+            from->empty.Push(next);
+            from->emptyWake.Notify();
+        }
+    }
+}
+
+OutputManager* OutputManager::Instance() {
+    static OutputManager theManager;
+    return &theManager;
+}
+
+OutputManager::OutputManager() : fMessenger(0), fAsync(false), fQueueDepth(64), fMerge(false), fBackend("root"),
+                                 fFileName("apollon_out_run{run}"), fRunID(0), fRunFileName(""), fBasketSize(32000),
+                                 fCompression(1), fEventLayout(false) {
+    fMessenger = new OutputMessenger(this);
+}
+
+OutputManager::~OutputManager() {
+    delete fMessenger;
+}
+
+void OutputManager::OpenFile(G4int runID) {
+
+    // The master runs first and expands the name for the whole run;
+    // worker files get their thread suffix from the analysis manager
+    if (G4Threading::IsMasterThread()) {
+        fRunID = runID;
+        fRunFileName = ExpandFileName(fFileName);
+        fColumnFormats.Clear();
+        fBookedFormats.clear();
+    }
+
+#if G4VERSION_NUMBER >= 1100
+    G4GenericAnalysisManager* analysisManager = G4GenericAnalysisManager::Instance();
+    if (IsWriting()) analysisManager->SetDefaultFileType(fBackend);
+    analysisManager->SetBasketSize(fBasketSize);
+#else
+    // Before 11.0 there is no generic manager, only one per format
+    G4VAnalysisManager* analysisManager = 0;
+    if (fBackend == "csv") {
+        analysisManager = G4CsvAnalysisManager::Instance();
+    }
+    else {
+        G4RootAnalysisManager* rootManager = G4RootAnalysisManager::Instance();
+        rootManager->SetBasketSize(fBasketSize);
+        analysisManager = rootManager;
+    }
+#endif
+    analysisManager->SetCompressionLevel(fCompression);
+    threadAnalysisManager = analysisManager;
+    if (!threadVectors) threadVectors = new VectorColumns();
+    threadVectors->BeginOfRun();
+
+    // Ntuples are still booked without a file, their rows are dropped
+    // or, when merged, written by the master
+    threadMerging = fMerge && IsWriting() && G4Threading::IsMultithreadedApplication();
+    threadFileOpen = IsWriting() && !(threadMerging && G4Threading::IsWorkerThread());
+    if (threadFileOpen) analysisManager->OpenFile(fRunFileName);
+}
+
+G4VAnalysisManager* OutputManager::GetAnalysisManager() const {
+    return threadAnalysisManager;
+}
+
+G4int OutputManager::CreateNtupleRealColumn(G4int ntupleId, const G4String& ntupleName, const G4String& name) {
+
+    ColumnFormat format = FindPrecision(ntupleName, name);
+    G4int column = -1;
+    if (format.storage == kStoreFloat) column = threadAnalysisManager->CreateNtupleFColumn(ntupleId, name);
+    else if (format.storage == kStoreFixed) column = threadAnalysisManager->CreateNtupleIColumn(ntupleId, name);
+    else column = threadAnalysisManager->CreateNtupleDColumn(ntupleId, name);
+
+    // Every thread books the same columns; the master keeps the table
+    if (G4Threading::IsMasterThread()) {
+        fColumnFormats.Set(ntupleId, column, format);
+        RecordFormat(ntupleName, name, format);
+    }
+    return column;
+}
+
+G4int OutputManager::CreateNtupleIVectorColumn(G4int ntupleId, const G4String& name) {
+    return threadVectors->CreateIColumn(threadAnalysisManager, ntupleId, name);
+}
+
+G4int OutputManager::CreateNtupleRealVectorColumn(G4int ntupleId, const G4String& ntupleName,
+                                                  const G4String& flatName, const G4String& name) {
+
+    // The Formats row names the flat column, which stands for the vector
+    // columns of every detector; without an ntuple name it is a double
+    ColumnFormat format;
+    if (!ntupleName.empty()) {
+        format = FindPrecision(ntupleName, flatName);
+        if (G4Threading::IsMasterThread()) RecordFormat(ntupleName, flatName, format);
+    }
+    return threadVectors->CreateRealColumn(threadAnalysisManager, ntupleId, name, format);
+}
+
+ColumnFormat OutputManager::FindPrecision(const G4String& ntupleName, const G4String& name) const {
+
+    std::map<G4String, ColumnFormat>::const_iterator it = fPrecision.find(ntupleName + "/" + name);
+    if (it != fPrecision.end()) return it->second;
+    return ColumnFormat();
+}
+
+void OutputManager::RecordFormat(const G4String& ntupleName, const G4String& name, const ColumnFormat& format) {
+
+    for (std::size_t ii = 0; ii < fBookedFormats.size(); ++ii) {
+        if (fBookedFormats[ii].ntuple == ntupleName && fBookedFormats[ii].column == name) return;
+    }
+    BookedFormat booked;
+    booked.ntuple = ntupleName;
+    booked.column = name;
+    booked.format = format;
+    fBookedFormats.push_back(booked);
+}
+
+void OutputManager::FillColumnFormats(G4int ntupleId) const {
+
+    // Written to every file, so that each can be read on its own
+    if (!threadFileOpen) return;
+
+    const char* storageNames[] = {"double", "float", "fixed"};
+    for (std::size_t ii = 0; ii < fBookedFormats.size(); ++ii) {
+        const BookedFormat& booked = fBookedFormats[ii];
+        threadAnalysisManager->FillNtupleSColumn(ntupleId, 0, booked.ntuple);
+        threadAnalysisManager->FillNtupleSColumn(ntupleId, 1, booked.column);
+        threadAnalysisManager->FillNtupleSColumn(ntupleId, 2, storageNames[booked.format.storage]);
+        threadAnalysisManager->FillNtupleDColumn(ntupleId, 3, booked.format.scale);
+        threadAnalysisManager->AddNtupleRow(ntupleId);
+    }
+}
+
+void OutputManager::BeginOfRun() {
+
+    // The master of a multithreaded run processes no events
+    G4bool processesEvents = !(G4Threading::IsMultithreadedApplication() && G4Threading::IsMasterThread());
+    if (threadMerging && !processesEvents) {
+        // Runs before any worker starts the run
+        G4int nworkers = G4MTRunManager::GetMasterRunManager()->GetNumberOfThreads();
+        merger = new EventMerger(threadAnalysisManager, threadVectors, nworkers);
+        merger->writer = std::thread(RunMerger, merger);
+        currentBatch = new OutputBatch();
+    }
+    else if (threadMerging) {
+        pipeline = new WriterPipeline(0, 0, fQueueDepth + 1, &merger->wake);
+        currentBatch = pipeline->empty.Pop();
+        {
+            G4AutoLock lock(&merger->wake.mutex);
+            merger->streams.push_back(pipeline);
+        }
+        merger->wake.condition.notify_all();
+    }
+    else if (fAsync && threadFileOpen && processesEvents) {
+        pipeline = new WriterPipeline(threadAnalysisManager, threadVectors, fQueueDepth + 1, 0);
+        currentBatch = pipeline->empty.Pop();
+        pipeline->writer = std::thread(RunWriter, pipeline);
+    }
+    else {
+        // No writer thread: rows go straight to the analysis manager
+        currentBatch = new OutputBatch();
+        if (!processesEvents) return;
+        if (threadFileOpen) currentBatch->PassFills(threadAnalysisManager, &fColumnFormats, threadVectors);
+        else currentBatch->DropFills();
+    }
+}
+
+void OutputManager::EndOfRun() {
+
+    if (!currentBatch) return;
+
+    // Rows still pending are written before the file is closed; rows of
+    // an unfinished event go last
+    if (pipeline) {
+        if (!currentBatch->IsEmpty()) {
+            currentBatch->SetEventID(std::numeric_limits<G4int>::max());
+            pipeline->filled.Push(currentBatch);
+        }
+        pipeline->done.store(true, std::memory_order_release);
+        pipeline->filledWake->Notify();
+        // A merged stream is emptied and deleted by the master
+        if (!threadMerging) {
+            pipeline->writer.join();
+            delete pipeline;
+        }
+        pipeline = 0;
+    }
+    else {
+        if (threadFileOpen) currentBatch->Replay(threadAnalysisManager, fColumnFormats, threadVectors);
+        delete currentBatch;
+    }
+    currentBatch = 0;
+
+    // The master ends its run after every worker
+    if (merger && G4Threading::IsMasterThread()) {
+        merger->closed.store(true, std::memory_order_release);
+        merger->wake.Notify();
+        merger->writer.join();
+        delete merger;
+        merger = 0;
+    }
+
+    if (threadFileOpen) {
+        threadAnalysisManager->Write();
+        threadAnalysisManager->CloseFile();
+        threadFileOpen = false;
+    }
+
+    // RunAction books every ntuple again at the start of the next run,
+    // under the same IDs and with the settings of that run
+#if G4VERSION_NUMBER >= 1100
+    threadAnalysisManager->Clear();
+#else
+    // No Clear() before 11.0; the next Instance() is a fresh manager
+    delete threadAnalysisManager;
+#endif
+    threadAnalysisManager = 0;
+}
+
+OutputBatch* OutputManager::GetBatch() const {
+    return currentBatch;
+}
+
+void OutputManager::EndEvent(G4int evid) const {
+
+    // Without a writer the rows have been written as they came
+    if (!pipeline) {
+        currentBatch->Clear();
+        return;
+    }
+    currentBatch->SetEventID(evid);
+    if (currentBatch->IsEmpty()) return;
+
+    // Waits only when the writer has fallen a full queue behind
+    pipeline->filled.Push(currentBatch);
+    pipeline->filledWake->Notify();
+    OutputBatch* next = pipeline->empty.Pop();
+    if (!next) {
+        G4AutoLock lock(&pipeline->emptyWake.mutex);
+        while (!(next = pipeline->empty.Pop())) pipeline->emptyWake.condition.wait(lock);
+    }
+    currentBatch = next;
+}
+
+void OutputManager::SetAsync(G4bool async) {
+    fAsync = async;
+}
+
+void OutputManager::SetMerge(G4bool merge) {
+    fMerge = merge;
+}
+
+void OutputManager::SetQueueDepth(G4int depth) {
+    fQueueDepth = depth;
+}
+
+void OutputManager::SetBackend(const G4String& backend) {
+
+#if G4VERSION_NUMBER < 1100
+    if (backend == "hdf5") {
+        G4Exception("OutputManager::SetBackend", "Apollon025", JustWarning,
+                    "HDF5 output needs the generic analysis manager of Geant4 11.0 or later; output format unchanged.");
+        return;
+    }
+#endif
+    fBackend = backend;
+}
+
+void OutputManager::SetPrecision(const G4String& ntuple, const G4String& column, const G4String& storage,
+                                 G4double scale) {
+
+    ColumnFormat format;
+    if (storage == "float") {
+        format.storage = kStoreFloat;
+    }
+    else if (storage == "fixed") {
+        if (scale <= 0.) {
+            G4Exception("OutputManager::SetPrecision", "Apollon027", JustWarning,
+                        "Fixed-point storage needs a positive scale; column storage unchanged.");
+            return;
+        }
+        format.storage = kStoreFixed;
+        format.scale = scale;
+    }
+    fPrecision[ntuple + "/" + column] = format;
+}
+
+void OutputManager::SetLayout(const G4String& layout) {
+    fEventLayout = (layout == "event");
+}
+
+void OutputManager::SetFileName(const G4String& fname) {
+    fFileName = fname;
+}
+
+void OutputManager::SetParameter(const G4String& name, const G4String& value) {
+    fParameters[name] = value;
+}
+
+void OutputManager::ClearParameters() {
+    fParameters.clear();
+}
+
+void OutputManager::SetBasketSize(G4int size) {
+    fBasketSize = size;
+}
+
+void OutputManager::SetCompressionLevel(G4int level) {
+    fCompression = level;
+}
+
+G4String OutputManager::ExpandFileName(const G4String& pattern) const {
+
+    // {run} and {seed} are built in, any other {name} is a parameter
+    std::ostringstream oss;
+    std::size_t pos = 0;
+    while (pos < pattern.size()) {
+        std::size_t open = pattern.find('{', pos);
+        std::size_t close = (open == std::string::npos) ? open : pattern.find('}', open);
+        if (close == std::string::npos) {
+            oss << pattern.substr(pos);
+            break;
+        }
+        oss << pattern.substr(pos, open - pos);
+
+        G4String key = pattern.substr(open + 1, close - open - 1);
+        std::map<G4String, G4String>::const_iterator it = fParameters.find(key);
+        if (key == "run") {
+            oss << fRunID;
+        }
+        else if (key == "seed") {
+            oss << G4Random::getTheSeed();
+        }
+        else if (it != fParameters.end()) {
+            oss << it->second;
+        }
+        else {
+            G4ExceptionDescription msg;
+            msg << "No output parameter " << key << " (/output/setParameter); left as it is in the file name.";
+            G4Exception("OutputManager::ExpandFileName", "Apollon026", JustWarning, msg);
+            oss << key;
+        }
+        pos = close + 1;
+    }
+    return oss.str();
+}
+
+G4String OutputManager::GetRunFileName(const G4String& name) const {
+    return fRunFileName + "_" + name;
+}
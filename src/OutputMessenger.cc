@@ -0,0 +1,159 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for OutputMessenger class
+// Last edited: 17/10/2026
+//
+
+#include <sstream>
+
+#include "OutputMessenger.hh"
+#include "OutputManager.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+OutputMessenger::OutputMessenger(OutputManager* manager) : G4UImessenger(), fManager(manager) {
+
+    // Settings are read by every thread at the start of the run, so commands run on the master only
+    fDirectory = new G4UIdirectory("/output/");
+    fDirectory->SetGuidance("Ntuple output settings.");
+
+    fAsyncCmd = new G4UIcmdWithABool("/output/async", this);
+    fAsyncCmd->SetGuidance("Write ntuple rows from a separate writer thread for each worker.");
+    fAsyncCmd->SetGuidance("Workers then never wait on basket compression, only on a full queue.");
+    fAsyncCmd->SetParameterName("async", false);
+    fAsyncCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fAsyncCmd->SetToBeBroadcasted(false);
+
+    fQueueDepthCmd = new G4UIcmdWithAnInteger("/output/queueDepth", this);
+    fQueueDepthCmd->SetGuidance("Number of events a worker may run ahead of its writer thread.");
+    fQueueDepthCmd->SetParameterName("depth", false);
+    fQueueDepthCmd->SetRange("depth > 0");
+    fQueueDepthCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fQueueDepthCmd->SetToBeBroadcasted(false);
+
+    fMergeCmd = new G4UIcmdWithABool("/output/merge", this);
+    fMergeCmd->SetGuidance("Write one file from the master, with the rows of all workers in event order.");
+    fMergeCmd->SetGuidance("The rows then do not depend on the number of threads; /output/async is not needed.");
+    fMergeCmd->SetParameterName("merge", false);
+    fMergeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fMergeCmd->SetToBeBroadcasted(false);
+
+    fBackendCmd = new G4UIcmdWithAString("/output/backend", this);
+    fBackendCmd->SetGuidance("Select the ntuple output format; none books the ntuples but writes no file.");
+    fBackendCmd->SetGuidance("HDF5 needs Geant4 11.0 or later built with HDF5 support.");
+    fBackendCmd->SetParameterName("backend", false);
+    fBackendCmd->SetCandidates("root hdf5 csv none");
+    fBackendCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fBackendCmd->SetToBeBroadcasted(false);
+
+    fFileNameCmd = new G4UIcmdWithAString("/output/fileName", this);
+    fFileNameCmd->SetGuidance("Set the output file name, without extension, expanded at the start of each run.");
+    fFileNameCmd->SetGuidance("{run} is the run number, {seed} the master seed and {name} an /output/setParameter value.");
+    fFileNameCmd->SetParameterName("fileName", false);
+    fFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFileNameCmd->SetToBeBroadcasted(false);
+
+    fParameterCmd = new G4UIcommand("/output/setParameter", this);
+    fParameterCmd->SetGuidance("Set a named value for use as {name} in the output file name, e.g. a scanned parameter.");
+    G4UIparameter* name = new G4UIparameter("name", 's', false);
+    fParameterCmd->SetParameter(name);
+    G4UIparameter* value = new G4UIparameter("value", 's', false);
+    fParameterCmd->SetParameter(value);
+    fParameterCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fParameterCmd->SetToBeBroadcasted(false);
+
+    fClearParametersCmd = new G4UIcmdWithoutParameter("/output/clearParameters", this);
+    fClearParametersCmd->SetGuidance("Remove all file name parameters.");
+    fClearParametersCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fClearParametersCmd->SetToBeBroadcasted(false);
+
+    fBasketSizeCmd = new G4UIcmdWithAnInteger("/output/basketSize", this);
+    fBasketSizeCmd->SetGuidance("Set the ROOT basket size or HDF5 chunk size of the ntuple columns, in bytes.");
+    fBasketSizeCmd->SetParameterName("size", false);
+    fBasketSizeCmd->SetRange("size > 0");
+    fBasketSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fBasketSizeCmd->SetToBeBroadcasted(false);
+
+    fCompressionCmd = new G4UIcmdWithAnInteger("/output/compression", this);
+    fCompressionCmd->SetGuidance("Set the compression level of the output file (0: none, 9: smallest).");
+    fCompressionCmd->SetParameterName("level", false);
+    fCompressionCmd->SetRange("level >= 0 && level <= 9");
+    fCompressionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fCompressionCmd->SetToBeBroadcasted(false);
+
+    fPrecisionCmd = new G4UIcommand("/output/precision", this);
+    fPrecisionCmd->SetGuidance("Set the storage of a real column of the Hits or Bdx ntuple.");
+    fPrecisionCmd->SetGuidance("fixed stores the nearest integer number of scale steps, in the units of the column.");
+    G4UIparameter* ntuple = new G4UIparameter("ntuple", 's', false);
+    ntuple->SetParameterCandidates("Hits Bdx");
+    fPrecisionCmd->SetParameter(ntuple);
+    G4UIparameter* column = new G4UIparameter("column", 's', false);
+    fPrecisionCmd->SetParameter(column);
+    G4UIparameter* storage = new G4UIparameter("storage", 's', false);
+    storage->SetParameterCandidates("double float fixed");
+    fPrecisionCmd->SetParameter(storage);
+    G4UIparameter* scale = new G4UIparameter("scale", 'd', true);
+    scale->SetDefaultValue(0.);
+    fPrecisionCmd->SetParameter(scale);
+    fPrecisionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPrecisionCmd->SetToBeBroadcasted(false);
+
+    fLayoutCmd = new G4UIcmdWithAString("/output/layout", this);
+    fLayoutCmd->SetGuidance("Select the layout of the Hits, Tracks and Bdx ntuples.");
+    fLayoutCmd->SetGuidance("flat: one row per hit, track or crossing, each with its event ID.");
+    fLayoutCmd->SetGuidance("event: one row per event in HitEvents, TrackEvents and BdxEvents, with vector columns.");
+    fLayoutCmd->SetParameterName("layout", false);
+    fLayoutCmd->SetCandidates("flat event");
+    fLayoutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fLayoutCmd->SetToBeBroadcasted(false);
+}
+
+OutputMessenger::~OutputMessenger() {
+    delete fDirectory;
+    delete fAsyncCmd;
+    delete fQueueDepthCmd;
+    delete fMergeCmd;
+    delete fBackendCmd;
+    delete fFileNameCmd;
+    delete fParameterCmd;
+    delete fClearParametersCmd;
+    delete fBasketSizeCmd;
+    delete fCompressionCmd;
+    delete fPrecisionCmd;
+    delete fLayoutCmd;
+}
+
+void OutputMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fAsyncCmd) fManager->SetAsync(fAsyncCmd->GetNewBoolValue(newValue));
+    if (command == fQueueDepthCmd) fManager->SetQueueDepth(fQueueDepthCmd->GetNewIntValue(newValue));
+    if (command == fMergeCmd) fManager->SetMerge(fMergeCmd->GetNewBoolValue(newValue));
+    if (command == fBackendCmd) fManager->SetBackend(newValue);
+    if (command == fFileNameCmd) fManager->SetFileName(newValue);
+    if (command == fParameterCmd) {
+        std::istringstream iss(newValue);
+        G4String name, value;
+        iss >> name >> value;
+        fManager->SetParameter(name, value);
+    }
+    if (command == fClearParametersCmd) fManager->ClearParameters();
+    if (command == fBasketSizeCmd) fManager->SetBasketSize(fBasketSizeCmd->GetNewIntValue(newValue));
+    if (command == fPrecisionCmd) {
+        std::istringstream iss(newValue);
+        G4String ntuple, column, storage;
+        G4double scale;
+        iss >> ntuple >> column >> storage >> scale;
+        fManager->SetPrecision(ntuple, column, storage, scale);
+    }
+    if (command == fCompressionCmd) fManager->SetCompressionLevel(fCompressionCmd->GetNewIntValue(newValue));
+    if (command == fLayoutCmd) fManager->SetLayout(newValue);
+
+}
@@ -0,0 +1,64 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for PhaseSpaceMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "PhaseSpaceMessenger.hh"
+#include "PhaseSpaceWriter.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+PhaseSpaceMessenger::PhaseSpaceMessenger(PhaseSpaceWriter* writer) : G4UImessenger(), fWriter(writer) {
+
+    fDirectory = new G4UIdirectory("/phasespace/");
+    fDirectory->SetGuidance("Recording of particles crossing a scoring plane, for restarting downstream runs.");
+
+    fRecordCmd = new G4UIcmdWithABool("/phasespace/record", this);
+    fRecordCmd->SetGuidance("Record particles crossing the scoring plane in the +z direction.");
+    fRecordCmd->SetParameterName("record", false);
+    fRecordCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fRecordCmd->SetToBeBroadcasted(false);
+
+    fFileNameCmd = new G4UIcmdWithAString("/phasespace/fileName", this);
+    fFileNameCmd->SetGuidance("Set the phase-space output file; {run}, {seed} and {name} are expanded as in /output/fileName.");
+    fFileNameCmd->SetParameterName("fileName", false);
+    fFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFileNameCmd->SetToBeBroadcasted(false);
+
+    fPlaneZCmd = new G4UIcmdWithADoubleAndUnit("/phasespace/planeZ", this);
+    fPlaneZCmd->SetGuidance("Set the z position of the scoring plane (default: chamber exit).");
+    fPlaneZCmd->SetParameterName("planeZ", false);
+    fPlaneZCmd->SetUnitCategory("Length");
+    fPlaneZCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPlaneZCmd->SetToBeBroadcasted(false);
+
+    fKillCmd = new G4UIcmdWithABool("/phasespace/killAtPlane", this);
+    fKillCmd->SetGuidance("Stop tracking particles once they have been recorded at the plane.");
+    fKillCmd->SetParameterName("kill", false);
+    fKillCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fKillCmd->SetToBeBroadcasted(false);
+}
+
+PhaseSpaceMessenger::~PhaseSpaceMessenger() {
+    delete fDirectory;
+    delete fRecordCmd;
+    delete fFileNameCmd;
+    delete fPlaneZCmd;
+    delete fKillCmd;
+}
+
+void PhaseSpaceMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fRecordCmd) fWriter->SetRecording(fRecordCmd->GetNewBoolValue(newValue));
+    if (command == fFileNameCmd) fWriter->SetFileName(newValue);
+    if (command == fPlaneZCmd) fWriter->SetPlaneZ(fPlaneZCmd->GetNewDoubleValue(newValue));
+    if (command == fKillCmd) fWriter->SetKillAtPlane(fKillCmd->GetNewBoolValue(newValue));
+
+}
@@ -0,0 +1,135 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for PhaseSpaceReader class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "PhaseSpaceReader.hh"
+
+#include "G4AutoLock.hh"
+
+namespace {
+    G4Mutex readerMutex = G4MUTEX_INITIALIZER;
+}
+
+PhaseSpaceReader* PhaseSpaceReader::Instance() {
+    static PhaseSpaceReader theReader;
+    return &theReader;
+}
+
+PhaseSpaceReader* PhaseSpaceReader::Open(const G4String& fname) {
+
+    PhaseSpaceReader* theReader = Instance();
+
+    G4AutoLock lock(&readerMutex);
+    if (theReader->fRecords && theReader->fFileName == fname) return theReader;
+    if (!theReader->Map(fname)) return nullptr;
+    return theReader;
+}
+
+PhaseSpaceReader::PhaseSpaceReader() : fFileName(""), fMapping(0), fMappingSize(0), fRecords(0),
+                                       fNRecords(0), fCursor(0), fWrapped(false)
+{}
+
+PhaseSpaceReader::~PhaseSpaceReader() {
+    Unmap();
+}
+
+G4bool PhaseSpaceReader::Map(const G4String& fname) {
+
+    Unmap();
+
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open phase-space file " << fname << ".";
+        G4Exception("PhaseSpaceReader::Map", "Apollon003", JustWarning, msg);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(PhaseSpaceHeader)) {
+        close(fd);
+        G4ExceptionDescription msg;
+        msg << "Phase-space file " << fname << " is too short to hold a header.";
+        G4Exception("PhaseSpaceReader::Map", "Apollon004", JustWarning, msg);
+        return false;
+    }
+
+    std::size_t size = st.st_size;
+    void* mapping = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        G4ExceptionDescription msg;
+        msg << "Cannot memory-map phase-space file " << fname << ".";
+        G4Exception("PhaseSpaceReader::Map", "Apollon005", JustWarning, msg);
+        return false;
+    }
+
+    const PhaseSpaceHeader* header = static_cast<const PhaseSpaceHeader*>(mapping);
+    G4bool valid = std::memcmp(header->magic, kPhaseSpaceMagic, sizeof(kPhaseSpaceMagic)) == 0
+                   && header->version == kPhaseSpaceVersion
+                   && header->recordSize == sizeof(PhaseSpaceRecord)
+                   && header->nRecords > 0
+                   && header->nRecords <= (size - sizeof(PhaseSpaceHeader))/sizeof(PhaseSpaceRecord);
+    if (!valid) {
+        munmap(mapping, size);
+        G4ExceptionDescription msg;
+        msg << "File " << fname << " is not a valid phase-space file (version " << kPhaseSpaceVersion << ").";
+        G4Exception("PhaseSpaceReader::Map", "Apollon006", JustWarning, msg);
+        return false;
+    }
+
+    // Records are read once each, roughly front to back
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    fFileName = fname;
+    fMapping = mapping;
+    fMappingSize = size;
+    fRecords = reinterpret_cast<const PhaseSpaceRecord*>(static_cast<const char*>(mapping) + sizeof(PhaseSpaceHeader));
+    fNRecords = header->nRecords;
+    Rewind();
+
+    G4cout << "Phase-space file " << fname << " mapped: " << fNRecords << " records." << G4endl;
+    return true;
+}
+
+void PhaseSpaceReader::Unmap() {
+
+    if (fMapping) munmap(fMapping, fMappingSize);
+    fFileName = "";
+    fMapping = 0;
+    fMappingSize = 0;
+    fRecords = 0;
+    fNRecords = 0;
+}
+
+uint64_t PhaseSpaceReader::Claim(uint64_t n) {
+
+    uint64_t first = fCursor.fetch_add(n, std::memory_order_relaxed);
+    if (first + n > fNRecords && !fWrapped.exchange(true)) {
+        G4ExceptionDescription msg;
+        msg << "All " << fNRecords << " records of " << fFileName << " used; recycling from the start.";
+        G4Exception("PhaseSpaceReader::Claim", "Apollon007", JustWarning, msg);
+    }
+    return first;
+}
+
+const PhaseSpaceRecord& PhaseSpaceReader::GetRecord(uint64_t index) const {
+    return fRecords[index % fNRecords];
+}
+
+void PhaseSpaceReader::Rewind() {
+    fCursor.store(0);
+    fWrapped.store(false);
+}
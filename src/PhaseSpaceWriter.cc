@@ -0,0 +1,155 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for PhaseSpaceWriter class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cstring>
+
+#include "PhaseSpaceWriter.hh"
+#include "PhaseSpaceMessenger.hh"
+#include "OutputManager.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4AutoLock.hh"
+#include "geomdefs.hh"
+
+namespace {
+    G4Mutex writerMutex = G4MUTEX_INITIALIZER;
+
+    // Records are handed to the shared file in blocks of this size
+    const std::size_t kBufferSize = 65536;
+    G4ThreadLocal std::vector<PhaseSpaceRecord>* threadBuffer = 0;
+}
+
+PhaseSpaceWriter* PhaseSpaceWriter::Instance() {
+    static PhaseSpaceWriter theWriter;
+    return &theWriter;
+}
+
+PhaseSpaceWriter::PhaseSpaceWriter() : fMessenger(0), fEnabled(false), fFileName("apollon_ps_run{run}.bin"),
+                                       fRunFileName(""), fPlaneZ(-1425.*mm), fKillAtPlane(false), fFile(0), fNRecords(0) {
+    // Default plane is the chamber exit (relToChamberExit in DetectorConstruction)
+    fMessenger = new PhaseSpaceMessenger(this);
+}
+
+PhaseSpaceWriter::~PhaseSpaceWriter() {
+    Close();
+    for (std::size_t ii = 0; ii < fBuffers.size(); ++ii) delete fBuffers[ii];
+    delete fMessenger;
+}
+
+void PhaseSpaceWriter::Open() {
+
+    if (!fEnabled || fFile) return;
+
+    fRunFileName = OutputManager::Instance()->ExpandFileName(fFileName);
+    fFile = std::fopen(fRunFileName.c_str(), "wb");
+    if (!fFile) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open phase-space output file " << fRunFileName << "; recording disabled for this run.";
+        G4Exception("PhaseSpaceWriter::Open", "Apollon010", JustWarning, msg);
+        return;
+    }
+    fNRecords = 0;
+    WriteHeader();
+}
+
+void PhaseSpaceWriter::Close() {
+
+    if (!fFile) return;
+
+    // Header is rewritten with the final record count
+    std::fseek(fFile, 0, SEEK_SET);
+    WriteHeader();
+    std::fclose(fFile);
+    fFile = 0;
+
+    G4cout << "Phase-space file " << fRunFileName << " written: " << fNRecords
+           << " records at z = " << fPlaneZ/mm << " mm." << G4endl;
+}
+
+void PhaseSpaceWriter::WriteHeader() {
+
+    PhaseSpaceHeader header;
+    std::memcpy(header.magic, kPhaseSpaceMagic, sizeof(kPhaseSpaceMagic));
+    header.version = kPhaseSpaceVersion;
+    header.recordSize = sizeof(PhaseSpaceRecord);
+    header.nRecords = fNRecords;
+    header.reserved = 0;
+    std::fwrite(&header, sizeof(header), 1, fFile);
+}
+
+G4bool PhaseSpaceWriter::IsForwardCrossing(const G4Step* aStep) const {
+
+    // A step ending on the plane is not counted: when the plane is a volume
+    // boundary, the crossing is the next step, starting on the plane
+    G4double preZ = aStep->GetPreStepPoint()->GetPosition().z();
+    G4double postZ = aStep->GetPostStepPoint()->GetPosition().z();
+    return preZ <= fPlaneZ + kCarTolerance && postZ > fPlaneZ + kCarTolerance;
+}
+
+void PhaseSpaceWriter::Record(const G4Step* aStep) {
+
+    const G4StepPoint* preStepPoint  = aStep->GetPreStepPoint();
+    const G4StepPoint* postStepPoint = aStep->GetPostStepPoint();
+
+    // Crossing point interpolated along the step
+    const G4ThreeVector& prePosition  = preStepPoint->GetPosition();
+    const G4ThreeVector& postPosition = postStepPoint->GetPosition();
+    G4double frac = (fPlaneZ - prePosition.z())/(postPosition.z() - prePosition.z());
+    G4ThreeVector position = prePosition + frac*(postPosition - prePosition);
+
+    // A step limited by geometry ends on the plane and has no discrete
+    // interaction; otherwise the interaction lies beyond the plane and the
+    // pre-step momentum is the one that crossed it.
+    const G4StepPoint* point = (postStepPoint->GetStepStatus() == fGeomBoundary) ? postStepPoint : preStepPoint;
+    G4ThreeVector momentum = point->GetMomentum();
+    const G4Track* track = aStep->GetTrack();
+
+    PhaseSpaceRecord record;
+    record.pdg    = track->GetParticleDefinition()->GetPDGEncoding();
+    record.x      = position.x()/mm;
+    record.y      = position.y()/mm;
+    record.z      = fPlaneZ/mm;
+    record.px     = momentum.x()/MeV;
+    record.py     = momentum.y()/MeV;
+    record.pz     = momentum.z()/MeV;
+    record.energy = point->GetKineticEnergy()/MeV;
+    record.weight = point->GetWeight();
+
+    if (!threadBuffer) {
+        threadBuffer = new std::vector<PhaseSpaceRecord>();
+        threadBuffer->reserve(kBufferSize);
+        G4AutoLock lock(&writerMutex);
+        fBuffers.push_back(threadBuffer);
+    }
+    threadBuffer->push_back(record);
+    if (threadBuffer->size() >= kBufferSize) Flush();
+}
+
+void PhaseSpaceWriter::Flush() {
+
+    if (!threadBuffer || threadBuffer->empty()) return;
+
+    G4AutoLock lock(&writerMutex);
+    if (fFile) {
+        std::fwrite(threadBuffer->data(), sizeof(PhaseSpaceRecord), threadBuffer->size(), fFile);
+        fNRecords += threadBuffer->size();
+    }
+    lock.unlock();
+
+    threadBuffer->clear();
+}
+
+void PhaseSpaceWriter::SetRecording(G4bool val) { fEnabled = val; }
+void PhaseSpaceWriter::SetFileName(const G4String& fname) { fFileName = fname; }
+void PhaseSpaceWriter::SetPlaneZ(G4double val) { fPlaneZ = val; }
+void PhaseSpaceWriter::SetKillAtPlane(G4bool val) { fKillAtPlane = val; }
@@ -1,132 +1,300 @@
 //
 // GEANT4 simulation of the Apollon 2022 experiment.
 // Geometry has been derived from the FLUKA simulation of the same experiment.
-// 
+//
 // Source file for PrimaryGeneratorAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
 #include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
+#include "EnergySampler.hh"
+#include "PhaseSpaceReader.hh"
+#include "SeedStore.hh"
+#include "OutputManager.hh"
+#include "OutputBatch.hh"
 
-#include "G4ParticleGun.hh"
 #include "G4Event.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
 #include "G4ParticleTable.hh"
 #include "Randomize.hh"
 
-#include "G4RootAnalysisManager.hh"
-
-PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction(), fParticleGun(0) {
-
-    // Generate one particle per event
-    fParticleGun = new G4ParticleGun(1);
+PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction(), fElectron(0),
+                        fEnergySampler(0), fPhaseSpaceReader(0), fPhaseSpaceFile(""), fPhaseSpacePDG(0),
+                        fPhaseSpaceParticle(0), fBunchSize(1), fGunWeight(1.), fMessenger(0) {
 
-    // Setting ParticleGun defaults
+    // Gun source fires electrons
 	G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
-	G4String particleName;
-	G4ParticleDefinition* particle = particleTable->FindParticle(particleName="e-");
-	fParticleGun->SetParticleDefinition(particle); // Setting particle type
+	fElectron = particleTable->FindParticle("e-");
 
+    // Energy spectrum defaults to the fit of the measured spectrum
+    fEnergySampler = new EnergySampler();
+    BuildDefaultSpectrum();
+
+    fMessenger = new PrimaryGeneratorMessenger(this);
 }
 
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction() {
-    delete fParticleGun;
+    delete fEnergySampler;
+    delete fMessenger;
 }
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent) {
 
-    // Generates a primary particle with random position about centre
-    // r0 small -> effective point source
-    
-    G4double r0 = 2.*nm; 
-    G4double radius = r0*(2.0*G4UniformRand() - 1.0);
-    G4double angle =  2*3.1415926545*G4UniformRand();
+    // Reseeds the engine when seeds are recorded or replayed; in replay
+    // mode the event also takes back its original event ID.
+    SeedStore::Instance()->BeginEvent(anEvent);
+    if (anEvent->IsAborted()) return;
+
+    // One event holds a bunch of fBunchSize primaries. Each quantity is
+    // sampled for the whole bunch in its own loop over contiguous arrays.
+    fX.resize(fBunchSize);
+    fY.resize(fBunchSize);
+    fZ.resize(fBunchSize);
+    fEnergy.resize(fBunchSize);
+    fTheta.resize(fBunchSize);
+    fPhi.resize(fBunchSize);
+    fWeight.resize(fBunchSize);
+
+    G4int nprimaries = fBunchSize;
+    if (fPhaseSpaceReader) {
+        nprimaries = ReadPhaseSpaceBunch(anEvent);
+    }
+    else {
+        SampleGunBunch(anEvent);
+    }
 
-    G4double x0 = radius*cos(angle);
-    G4double y0 = radius*sin(angle);
+    // Adding primary information to tree, one block per bunch; an
+    // aborted bunch keeps only the primaries read before the error
+    FillPrimaryNtuple(anEvent->GetEventID(), nprimaries);
+
+}
+
+void PrimaryGeneratorAction::SampleGunBunch(G4Event* anEvent) {
+
+    const G4int nn = fBunchSize;
+
+    // Five uniform numbers per primary, drawn in a single call
+    fUniforms.resize(5*nn);
+    G4Random::getTheEngine()->flatArray(5*nn, fUniforms.data());
+    const G4double* uRadius = fUniforms.data();
+    const G4double* uAngle  = uRadius + nn;
+    const G4double* uPhi    = uAngle + nn;
+    const G4double* uBin    = uPhi + nn;
+    const G4double* uEnergy = uBin + nn;
+
+    // Generates primary particles with random position about centre
+    // r0 small -> effective point source
+    G4double r0 = 2.*nm;
     G4double z0 = -2575.*mm;        // Centre of gas cell
     //G4double z0 = -2500.*mm;        // Matches Niall's simulations
-
-    fParticleGun->SetParticlePosition(G4ThreeVector(x0, y0, z0));
+    for (G4int ii = 0; ii < nn; ++ii) {
+        G4double radius = r0*(2.0*uRadius[ii] - 1.0);
+        G4double angle  = twopi*uAngle[ii];
+        fX[ii] = radius*std::cos(angle);
+        fY[ii] = radius*std::sin(angle);
+        fZ[ii] = z0;
+    }
 
 /*
     // Sampling energy from a flat distribution
     G4double Elower = 0.;
     G4double Eupper = 2.*GeV;
-
-    G4double energy = (Eupper - Elower)*G4UniformRand() + Elower;
-    fParticleGun->SetParticleEnergy(energy);
+    energy = (Eupper - Elower)*u + Elower;
 
     // Setting momentum direction (including beam divergence)
     G4double thetaMax = 1.*mrad;
-    G4double theta = thetaMax*G4UniformRand();
-    G4double phi   = 2.*3.1459265*G4UniformRand()*rad;
-    G4ThreeVector momentum(sin(theta)*cos(phi), sin(theta)*sin(phi), cos(theta));
-	fParticleGun->SetParticleMomentumDirection(momentum); // Setting momentum direction
+    theta = thetaMax*u;
 */
 
     // Sampling from experimental spectrum
-    G4double energy = this->SampleEnergyValue();
-    fParticleGun->SetParticleEnergy(energy);
+    for (G4int ii = 0; ii < nn; ++ii) {
+        fEnergy[ii] = fEnergySampler->Sample(uBin[ii], uEnergy[ii]);
+    }
+
+    // Beam divergence decreases with energy
+    for (G4int ii = 0; ii < nn; ++ii) {
+        fTheta[ii] = std::pow(0.6/(fEnergy[ii]/GeV), 1.4)*mrad;
+        fPhi[ii]   = twopi*uPhi[ii]*rad;
+    }
+
+    // Every gun primary stands for the same number of real electrons
+    for (G4int ii = 0; ii < nn; ++ii) {
+        fWeight[ii] = fGunWeight;
+    }
+
+    for (G4int ii = 0; ii < nn; ++ii) {
+        G4double sinTheta = std::sin(fTheta[ii]);
+        G4ThreeVector direction(sinTheta*std::cos(fPhi[ii]), sinTheta*std::sin(fPhi[ii]), std::cos(fTheta[ii]));
+        AddPrimary(anEvent, fElectron, G4ThreeVector(fX[ii], fY[ii], fZ[ii]), fEnergy[ii], direction, fWeight[ii]);
+    }
+}
+
+G4int PrimaryGeneratorAction::ReadPhaseSpaceBunch(G4Event* anEvent) {
+
+    // Primaries taken in turn from the shared phase-space file; a replayed
+    // event reads the same records as when it was first simulated
+    SeedStore* seedStore = SeedStore::Instance();
+    uint64_t first = 0;
+    if (seedStore->IsReplaying()) {
+        first = seedStore->GetPhaseSpaceIndex();
+    }
+    else {
+        first = fPhaseSpaceReader->Claim(fBunchSize);
+        seedStore->SetPhaseSpaceIndex(first);
+    }
+
+    // A record without momentum has no direction and is skipped, so the
+    // bunch may hold fewer primaries than records
+    G4int nprimaries = 0;
+    for (G4int ii = 0; ii < fBunchSize; ++ii) {
+        const PhaseSpaceRecord& record = fPhaseSpaceReader->GetRecord(first + ii);
+
+        if (record.pdg != fPhaseSpacePDG) {
+            fPhaseSpaceParticle = G4ParticleTable::GetParticleTable()->FindParticle(record.pdg);
+            fPhaseSpacePDG = record.pdg;
+        }
+        if (!fPhaseSpaceParticle) {
+            G4ExceptionDescription msg;
+            msg << "Unknown PDG code " << record.pdg << " in phase-space file " << fPhaseSpaceReader->GetFileName() << ".";
+            G4Exception("PrimaryGeneratorAction::ReadPhaseSpaceBunch", "Apollon008", EventMustBeAborted, msg);
+            return nprimaries;
+        }
 
-    G4double theta = pow((0.6/(energy/GeV)), 1.4)*mrad;
-    G4double phi   = 2.*3.1459265*G4UniformRand()*rad;
-    G4ThreeVector momentum(sin(theta)*cos(phi), sin(theta)*sin(phi), cos(theta));
-	fParticleGun->SetParticleMomentumDirection(momentum); // Setting momentum direction
+        G4ThreeVector momentum(record.px, record.py, record.pz);
+        if (momentum.mag2() <= 0.) {
+            G4ExceptionDescription msg;
+            msg << "Record " << (first + ii)%fPhaseSpaceReader->GetNumberOfRecords() << " of phase-space file "
+                << fPhaseSpaceReader->GetFileName() << " has zero momentum; skipped.";
+            G4Exception("PrimaryGeneratorAction::ReadPhaseSpaceBunch", "Apollon028", JustWarning, msg);
+            continue;
+        }
 
-    fParticleGun->GeneratePrimaryVertex(anEvent);
+        fX[nprimaries] = record.x*mm;
+        fY[nprimaries] = record.y*mm;
+        fZ[nprimaries] = record.z*mm;
+        fEnergy[nprimaries] = record.energy*MeV;
+        fTheta[nprimaries] = momentum.theta();
+        fPhi[nprimaries] = momentum.phi();
+        fWeight[nprimaries] = record.weight;
 
-    // Adding primary information to tree
-    G4RootAnalysisManager* analysisManager = G4RootAnalysisManager::Instance();
+        AddPrimary(anEvent, fPhaseSpaceParticle, G4ThreeVector(fX[nprimaries], fY[nprimaries], fZ[nprimaries]),
+                   fEnergy[nprimaries], momentum.unit(), fWeight[nprimaries]);
+        ++nprimaries;
+    }
+    return nprimaries;
+}
 
-    analysisManager->FillNtupleDColumn(3, 0, x0/mm);
-    analysisManager->FillNtupleDColumn(3, 1, y0/mm);
-    analysisManager->FillNtupleDColumn(3, 2, z0/mm);
-    analysisManager->FillNtupleDColumn(3, 3, energy/MeV);
-    analysisManager->FillNtupleDColumn(3, 4, theta/mrad);
-    analysisManager->FillNtupleDColumn(3, 5, phi/rad);
-    analysisManager->AddNtupleRow(3);
+void PrimaryGeneratorAction::AddPrimary(G4Event* anEvent, const G4ParticleDefinition* particle,
+                                        const G4ThreeVector& position, G4double energy,
+                                        const G4ThreeVector& direction, G4double weight) {
 
+    // The weight is copied to the primary track and inherited by its secondaries
+    G4PrimaryParticle* primary = new G4PrimaryParticle(particle);
+    primary->SetKineticEnergy(energy);
+    primary->SetMomentumDirection(direction);
+    primary->SetWeight(weight);
+
+    G4PrimaryVertex* vertex = new G4PrimaryVertex(position, 0.);
+    vertex->SetPrimary(primary);
+    anEvent->AddPrimaryVertex(vertex);
+}
+
+void PrimaryGeneratorAction::FillPrimaryNtuple(G4int evid, G4int nprimaries) {
+
+    OutputBatch* batch = OutputManager::Instance()->GetBatch();
+
+    for (G4int ii = 0; ii < nprimaries; ++ii) {
+        batch->FillNtupleDColumn(3, 0, fX[ii]/mm);
+        batch->FillNtupleDColumn(3, 1, fY[ii]/mm);
+        batch->FillNtupleDColumn(3, 2, fZ[ii]/mm);
+        batch->FillNtupleDColumn(3, 3, fEnergy[ii]/MeV);
+        batch->FillNtupleDColumn(3, 4, fTheta[ii]/mrad);
+        batch->FillNtupleDColumn(3, 5, fPhi[ii]/rad);
+        batch->FillNtupleIColumn(3, 6, evid);
+        batch->FillNtupleDColumn(3, 7, fWeight[ii]);
+        batch->AddNtupleRow(3);
+    }
 }
 
 G4double PrimaryGeneratorAction::SampleEnergyValue() {
+    return fEnergySampler->Sample();
+}
+
+void PrimaryGeneratorAction::SetSpectrum(const G4String& spectrum) {
+
+    if (spectrum == "builtin") {
+        BuildDefaultSpectrum();
+        return;
+    }
+    if (fEnergySampler->BuildFromFile(spectrum)) {
+        G4cout << "Primary energy spectrum read from " << spectrum << " ("
+               << fEnergySampler->GetEnergyMin()/MeV << " - " << fEnergySampler->GetEnergyMax()/MeV
+               << " MeV)" << G4endl;
+    }
+}
+
+void PrimaryGeneratorAction::SetSource(const G4String& source) {
+
+    if (source == "gun") {
+        fPhaseSpaceReader = 0;
+        return;
+    }
+
+    // source == "phasespace"
+    if (fPhaseSpaceFile.empty()) {
+        G4Exception("PrimaryGeneratorAction::SetSource", "Apollon009", JustWarning,
+                    "No phase-space file set (/beam/phaseSpaceFile); keeping the particle gun.");
+        return;
+    }
+    fPhaseSpaceReader = PhaseSpaceReader::Open(fPhaseSpaceFile);
+    fPhaseSpacePDG = 0;
+    fPhaseSpaceParticle = 0;
+}
+
+void PrimaryGeneratorAction::SetPhaseSpaceFile(const G4String& fname) {
+
+    fPhaseSpaceFile = fname;
+    if (fPhaseSpaceReader) {
+        fPhaseSpaceReader = PhaseSpaceReader::Open(fPhaseSpaceFile);
+        fPhaseSpacePDG = 0;
+        fPhaseSpaceParticle = 0;
+    }
+}
+
+void PrimaryGeneratorAction::SetBunchSize(G4int nn) {
+    fBunchSize = nn;
+}
+
+void PrimaryGeneratorAction::SetGunWeight(G4double weight) {
+    fGunWeight = weight;
+}
+
+void PrimaryGeneratorAction::BuildDefaultSpectrum() {
 
     // Following values taken from numerical fitting of
     // experimental spectrum.
-    G4double fitCoefficients[6] = {0.0029295798536937375,
-                                -1.966250866302375e-06,
-                                -1.1132757750710963e-08,
-                                2.0221298798397796e-11,
-                                -1.2508534257254872e-14,
-                                2.7354212401810846e-18};
-    G4double scaleC = 3.1523775432003887;
+    const G4double fitCoefficients[6] = {0.0029295798536937375,
+                                        -1.966250866302375e-06,
+                                        -1.1132757750710963e-08,
+                                        2.0221298798397796e-11,
+                                        -1.2508534257254872e-14,
+                                        2.7354212401810846e-18};
     G4double energyMax = 1609.0090089999999*MeV;
     G4double energyMin = 200.*MeV;
 
-    auto f = [fitCoefficients] (G4double xx) {
+    auto f = [&fitCoefficients] (G4double xx) {
         G4double sum = 0.;
-        for (int ii = 0; ii < 6; ++ii) {
-            sum += fitCoefficients[ii]*pow(xx, ii);
+        for (int ii = 5; ii >= 0; --ii) {
+            sum = sum*(xx/MeV) + fitCoefficients[ii];
         }
         return sum;
     };
 
-    // Sampling energy using acceptance-rejection method
-    G4bool acceptValue = false;
-    G4int counter = 0;
-    while (not acceptValue) {
-        G4double uu = G4UniformRand();
-        G4double xx = (energyMax - energyMin)*G4UniformRand() + energyMin;
-        G4double rr = f(xx)*(energyMax - energyMin)/scaleC;
-
-        if (uu <= rr) return xx;
-        ++counter;
-
-        if (counter > 10000) {
-            G4cout << "Failed to sample a value - returning minium energy." << G4endl;
-            break;
-        }
-    }
-    return energyMin;
-}
\ No newline at end of file
+    // Tabulated once; sampling is then O(1) per primary
+    fEnergySampler->BuildFromFunction(f, energyMin, energyMax, 4096);
+}
@@ -0,0 +1,75 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for PrimaryGeneratorMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "PrimaryGeneratorMessenger.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* gen) : G4UImessenger(),
+                                                        fPrimaryGenerator(gen) {
+
+    fBeamDir = new G4UIdirectory("/beam/");
+    fBeamDir->SetGuidance("Control of the primary electron beam.");
+
+    fSpectrumCmd = new G4UIcmdWithAString("/beam/spectrum", this);
+    fSpectrumCmd->SetGuidance("Set the primary energy spectrum.");
+    fSpectrumCmd->SetGuidance("  builtin  : polynomial fit to the measured Apollon spectrum");
+    fSpectrumCmd->SetGuidance("  <file>   : two-column text file of energy (MeV) and relative intensity");
+    fSpectrumCmd->SetParameterName("spectrum", false);
+    fSpectrumCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fSourceCmd = new G4UIcmdWithAString("/beam/source", this);
+    fSourceCmd->SetGuidance("Select the primary source.");
+    fSourceCmd->SetGuidance("  gun        : electrons sampled from the energy spectrum (default)");
+    fSourceCmd->SetGuidance("  phasespace : particles read from the file set by /beam/phaseSpaceFile");
+    fSourceCmd->SetParameterName("source", false);
+    fSourceCmd->SetCandidates("gun phasespace");
+    fSourceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fPhaseSpaceFileCmd = new G4UIcmdWithAString("/beam/phaseSpaceFile", this);
+    fPhaseSpaceFileCmd->SetGuidance("Set the binary phase-space file used by the phasespace source.");
+    fPhaseSpaceFileCmd->SetParameterName("fileName", false);
+    fPhaseSpaceFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fBunchSizeCmd = new G4UIcmdWithAnInteger("/beam/bunchSize", this);
+    fBunchSizeCmd->SetGuidance("Set the number of primaries generated in each event.");
+    fBunchSizeCmd->SetParameterName("bunchSize", false);
+    fBunchSizeCmd->SetRange("bunchSize>0");
+    fBunchSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fWeightCmd = new G4UIcmdWithADouble("/beam/weight", this);
+    fWeightCmd->SetGuidance("Set the statistical weight of each gun primary.");
+    fWeightCmd->SetGuidance("Phase-space primaries take their weight from the file.");
+    fWeightCmd->SetParameterName("weight", false);
+    fWeightCmd->SetRange("weight>0.");
+    fWeightCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger() {
+    delete fBeamDir;
+    delete fSpectrumCmd;
+    delete fSourceCmd;
+    delete fPhaseSpaceFileCmd;
+    delete fBunchSizeCmd;
+    delete fWeightCmd;
+}
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fSpectrumCmd) fPrimaryGenerator->SetSpectrum(newValue);
+    if (command == fSourceCmd) fPrimaryGenerator->SetSource(newValue);
+    if (command == fPhaseSpaceFileCmd) fPrimaryGenerator->SetPhaseSpaceFile(newValue);
+    if (command == fBunchSizeCmd) fPrimaryGenerator->SetBunchSize(fBunchSizeCmd->GetNewIntValue(newValue));
+    if (command == fWeightCmd) fPrimaryGenerator->SetGunWeight(fWeightCmd->GetNewDoubleValue(newValue));
+
+}
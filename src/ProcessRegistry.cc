@@ -0,0 +1,49 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ProcessRegistry class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "ProcessRegistry.hh"
+#include "OutputManager.hh"
+
+#include "G4ProcessTable.hh"
+#include "G4ProcessVector.hh"
+#include "G4VAnalysisManager.hh"
+
+ProcessRegistry* ProcessRegistry::Instance() {
+    static G4ThreadLocal ProcessRegistry* theRegistry = 0;
+    if (!theRegistry) theRegistry = new ProcessRegistry();
+    return theRegistry;
+}
+
+ProcessRegistry::ProcessRegistry()
+{}
+
+ProcessRegistry::~ProcessRegistry()
+{}
+
+void ProcessRegistry::Build() {
+
+    fLegend.clear();
+
+    G4ProcessVector* processes = G4ProcessTable::GetProcessTable()->FindProcesses();
+    for (std::size_t ii = 0; ii < processes->size(); ++ii) {
+        const G4VProcess* process = (*processes)[ii];
+        fLegend.insert(std::make_pair(GetID(process), process->GetProcessName()));
+    }
+    delete processes;
+}
+
+void ProcessRegistry::Fill(G4int ntupleId) const {
+
+    G4VAnalysisManager* analysisManager = OutputManager::Instance()->GetAnalysisManager();
+    for (std::set<std::pair<G4int, G4String> >::const_iterator it = fLegend.begin(); it != fLegend.end(); ++it) {
+        analysisManager->FillNtupleIColumn(ntupleId, 0, it->first);
+        analysisManager->FillNtupleSColumn(ntupleId, 1, it->second);
+        analysisManager->AddNtupleRow(ntupleId);
+    }
+}
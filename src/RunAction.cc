@@ -3,60 +3,169 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Source file for RunAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
 #include "RunAction.hh"
+#include "EventAction.hh"
+#include "PhaseSpaceReader.hh"
+#include "PhaseSpaceWriter.hh"
+#include "SeedStore.hh"
+#include "ProcessRegistry.hh"
+#include "ScoringMeshManager.hh"
+#include "ScreenImager.hh"
+#include "Cr39Scorer.hh"
+#include "TrackLengthFluence.hh"
+#include "EnergyLedger.hh"
+#include "MuonTruthStore.hh"
+#include "ConvergenceMonitor.hh"
+#include "OutputManager.hh"
+#include "SensitiveDetector.hh"
+#include "TrackingAction.hh"
 
 #include "G4Run.hh"
-#include "G4RootAnalysisManager.hh"
+#include "G4AccumulableManager.hh"
+#include "G4VAnalysisManager.hh"
 
-RunAction::RunAction() : G4UserRunAction() 
-{}
+namespace {
+    // Columns of the Hits, Tracks and Bdx ntuples after the event ID, in
+    // order; 'R' is a real column stored as set with /output/precision
+    struct ColumnSpec {
+        const char* name;
+        char type;      // 'I', 'D' or 'R'
+        G4bool full;    // Hits only: not booked for compact hits in the event layout
+    };
+
+    constexpr ColumnSpec hitColumns[] = {
+        {"x", 'R', false}, {"y", 'R', false}, {"z", 'R', false}, {"vtxx", 'R', true}, {"vtxy", 'R', true},
+        {"vtxz", 'R', true}, {"edep", 'R', false}, {"energy", 'R', true}, {"pdg", 'I', false},
+        {"procid", 'I', true}, {"detid", 'I', false}, {"trackid", 'I', false}, {"weight", 'R', false}
+    };
+    const ColumnSpec trackColumns[] = {
+        {"trackid", 'I', false}, {"pdg", 'I', false}, {"detid", 'I', false}, {"procid", 'I', false},
+        {"vtxx", 'D', false}, {"vtxy", 'D', false}, {"vtxz", 'D', false}, {"endx", 'D', false},
+        {"endy", 'D', false}, {"endz", 'D', false}, {"kEnergy", 'D', false}, {"weight", 'D', false}
+    };
+    const ColumnSpec bdxColumns[] = {
+        {"pdg", 'I', false}, {"detid", 'I', false}, {"procid", 'I', false}, {"x", 'R', false}, {"y", 'R', false},
+        {"z", 'R', false}, {"vtxx", 'R', false}, {"vtxy", 'R', false}, {"vtxz", 'R', false}, {"px", 'R', false},
+        {"py", 'R', false}, {"pz", 'R', false}, {"energy", 'R', false}, {"theta", 'R', false},
+        {"fluence", 'R', false}, {"weight", 'R', false}
+    };
+    const G4int nTrackColumns = sizeof(trackColumns)/sizeof(ColumnSpec);
+
+    constexpr G4int CountCompactColumns(const ColumnSpec* columns, G4int ncolumns) {
+        return (ncolumns == 0) ? 0 : (columns->full ? 0 : 1) + CountCompactColumns(columns + 1, ncolumns - 1);
+    }
+
+    // Filled by SensitiveDetector and TrackingAction in this order
+    static_assert(static_cast<G4int>(sizeof(hitColumns)/sizeof(ColumnSpec)) == kHitColumnsPerDetector, "Hits columns");
+    static_assert(CountCompactColumns(hitColumns, kHitColumnsPerDetector) == kCompactHitColumnsPerDetector,
+                  "Compact Hits columns");
+    static_assert(static_cast<G4int>(sizeof(trackColumns)/sizeof(ColumnSpec)) == kTrackColumnWeight, "Tracks columns");
+    static_assert(static_cast<G4int>(sizeof(bdxColumns)/sizeof(ColumnSpec)) == kBdxColumnsPerDetector, "Bdx columns");
+
+    // One row per hit, track or crossing
+    void CreateFlatNtuple(G4int ntupleId, const G4String& name, const G4String& evidName,
+                          const ColumnSpec* columns, G4int ncolumns) {
+
+        OutputManager* outputManager = OutputManager::Instance();
+        G4VAnalysisManager* analysisManager = outputManager->GetAnalysisManager();
+        analysisManager->CreateNtuple(name, name);
+        analysisManager->CreateNtupleIColumn(ntupleId, evidName);
+        for (G4int ii = 0; ii < ncolumns; ++ii) {
+            if (columns[ii].type == 'I') analysisManager->CreateNtupleIColumn(ntupleId, columns[ii].name);
+            else if (columns[ii].type == 'D') analysisManager->CreateNtupleDColumn(ntupleId, columns[ii].name);
+            else outputManager->CreateNtupleRealColumn(ntupleId, name, columns[ii].name);
+        }
+        analysisManager->FinishNtuple(ntupleId);
+    }
+
+    // One row per event: a vector column for each flat column, repeated
+    // for each detector when perDetector is set; the full-hit columns are
+    // left out for a detector keeping compact hits
+    void CreateEventNtuple(G4int ntupleId, const G4String& name, const G4String& flatName,
+                           const ColumnSpec* columns, G4int ncolumns, G4bool perDetector) {
+
+        OutputManager* outputManager = OutputManager::Instance();
+        G4VAnalysisManager* analysisManager = outputManager->GetAnalysisManager();
+        analysisManager->CreateNtuple(name, name);
+        analysisManager->CreateNtupleIColumn(ntupleId, "evid");
+        G4int ngroups = perDetector ? kNSummaryDetectors : 1;
+        for (G4int dd = 0; dd < ngroups; ++dd) {
+            G4String prefix = perDetector ? EventAction::GetDetectorName(dd) + "_" : G4String("");
+            G4bool compact = perDetector && SensitiveDetector::KeepsCompactHits(dd);
+            for (G4int ii = 0; ii < ncolumns; ++ii) {
+                if (compact && columns[ii].full) continue;
+                if (columns[ii].type == 'I') {
+                    outputManager->CreateNtupleIVectorColumn(ntupleId, prefix + columns[ii].name);
+                }
+                else {
+                    // Plain doubles are not listed in Formats
+                    G4String formatName = (columns[ii].type == 'R') ? flatName : G4String("");
+                    outputManager->CreateNtupleRealVectorColumn(ntupleId, formatName, columns[ii].name,
+                                                                prefix + columns[ii].name);
+                }
+            }
+        }
+        analysisManager->FinishNtuple(ntupleId);
+    }
+}
+
+RunAction::RunAction() : G4UserRunAction() {
+    // Created here so that its commands are registered by the master
+    PhaseSpaceWriter::Instance();
+    SeedStore::Instance();
+    fScorers.push_back(ScoringMeshManager::Instance());
+    fScorers.push_back(ScreenImager::Instance());
+    fScorers.push_back(Cr39Scorer::Instance());
+    fScorers.push_back(TrackLengthFluence::Instance());
+    fScorers.push_back(EnergyLedger::Instance());
+    MuonTruthStore::Instance();
+    ConvergenceMonitor::Instance();
+    OutputManager::Instance();
+
+    G4AccumulableManager::Instance()->RegisterAccumulable(&fTallies);
+}
 
 RunAction::~RunAction()
 {}
 
-void RunAction::BeginOfRunAction(const G4Run*) {
-
-    G4RootAnalysisManager* analysisManager = G4RootAnalysisManager::Instance();
-    analysisManager->OpenFile("apollon_out.root");
-
-    analysisManager->CreateNtuple("Hits", "Hits");
-    analysisManager->CreateNtupleIColumn(0, "evid");
-    analysisManager->CreateNtupleDColumn(0, "x");
-    analysisManager->CreateNtupleDColumn(0, "y");
-    analysisManager->CreateNtupleDColumn(0, "z");
-    analysisManager->CreateNtupleDColumn(0, "vtxx");
-    analysisManager->CreateNtupleDColumn(0, "vtxy");
-    analysisManager->CreateNtupleDColumn(0, "vtxz");
-    analysisManager->CreateNtupleDColumn(0, "edep");
-    analysisManager->CreateNtupleDColumn(0, "energy");
-    analysisManager->CreateNtupleIColumn(0, "pdg");
-    analysisManager->CreateNtupleIColumn(0, "procid");
-    analysisManager->CreateNtupleIColumn(0, "detid");
-    analysisManager->CreateNtupleIColumn(0, "trackid");
-    analysisManager->FinishNtuple(0);
+void RunAction::BeginOfRunAction(const G4Run* aRun) {
+
+    // Output format and file name are chosen with the /output/ commands
+    OutputManager* outputManager = OutputManager::Instance();
+    outputManager->OpenFile(aRun->GetRunID());
+    G4VAnalysisManager* analysisManager = outputManager->GetAnalysisManager();
+
+    if (IsMaster()) {
+        PhaseSpaceWriter::Instance()->Open();
+        // Every run reads the phase-space file from its first record
+        PhaseSpaceReader::Instance()->Rewind();
+        SeedStore::Instance()->Open();
+        for (std::size_t ii = 0; ii < fScorers.size(); ++ii) fScorers[ii]->BeginOfRun();
+        ConvergenceMonitor::Instance()->BeginOfRun();
+    }
+    for (std::size_t ii = 0; ii < fScorers.size(); ++ii) fScorers[ii]->ResetLocal();
+    ConvergenceMonitor::Instance()->ResetLocal();
+    G4AccumulableManager::Instance()->Reset();
+    fTallies.Resize(ConvergenceMonitor::Instance()->GetNumberOfTallies());
+
+    // Real columns of Hits and Bdx are stored as set with /output/precision;
+    // the event layout turns Hits, Tracks and Bdx into one row per event
+    G4bool eventLayout = outputManager->IsEventLayout();
+    if (eventLayout) CreateEventNtuple(0, "HitEvents", "Hits", hitColumns, kHitColumnsPerDetector, true);
+    else CreateFlatNtuple(0, "Hits", "evid", hitColumns, kHitColumnsPerDetector);
 
     analysisManager->CreateNtuple("Events", "Events");
     analysisManager->CreateNtupleIColumn(1, "evid");
     analysisManager->CreateNtupleDColumn(1, "edep");
+    analysisManager->CreateNtupleDColumn(1, "weight");
+    EventAction::CreateSummaryColumns(1);
     analysisManager->FinishNtuple(1);
 
-    analysisManager->CreateNtuple("Tracks", "Tracks");
-    analysisManager->CreateNtupleIColumn(2, "evid");
-    analysisManager->CreateNtupleIColumn(2, "trackid");
-    analysisManager->CreateNtupleIColumn(2, "pdg");
-    analysisManager->CreateNtupleIColumn(2, "detid");
-    analysisManager->CreateNtupleIColumn(2, "procid");
-    analysisManager->CreateNtupleDColumn(2, "vtxx");
-    analysisManager->CreateNtupleDColumn(2, "vtxy");
-    analysisManager->CreateNtupleDColumn(2, "vtxz");
-    analysisManager->CreateNtupleDColumn(2, "endx");
-    analysisManager->CreateNtupleDColumn(2, "endy");
-    analysisManager->CreateNtupleDColumn(2, "endz");
-    analysisManager->CreateNtupleDColumn(2, "kEnergy");
-    analysisManager->FinishNtuple(2);
+    if (eventLayout) CreateEventNtuple(2, "TrackEvents", "Tracks", trackColumns, nTrackColumns, false);
+    else CreateFlatNtuple(2, "Tracks", "evid", trackColumns, nTrackColumns);
 
     analysisManager->CreateNtuple("Primaries", "Primaries");
     analysisManager->CreateNtupleDColumn(3, "x");
@@ -65,36 +174,88 @@ void RunAction::BeginOfRunAction(const G4Run*) {
     analysisManager->CreateNtupleDColumn(3, "E");
     analysisManager->CreateNtupleDColumn(3, "theta");
     analysisManager->CreateNtupleDColumn(3, "phi");
+    analysisManager->CreateNtupleIColumn(3, "evid");
+    analysisManager->CreateNtupleDColumn(3, "weight");
     analysisManager->FinishNtuple(3);
 
-    analysisManager->CreateNtuple("Bdx", "Bdx");
-    analysisManager->CreateNtupleIColumn(4, "eventid");
-    analysisManager->CreateNtupleIColumn(4, "pdg");
-    analysisManager->CreateNtupleIColumn(4, "detid");
-    analysisManager->CreateNtupleIColumn(4, "procid");
-    analysisManager->CreateNtupleDColumn(4, "x");
-    analysisManager->CreateNtupleDColumn(4, "y");
-    analysisManager->CreateNtupleDColumn(4, "z");
-    analysisManager->CreateNtupleDColumn(4, "vtxx");
-    analysisManager->CreateNtupleDColumn(4, "vtxy");
-    analysisManager->CreateNtupleDColumn(4, "vtxz");
-    analysisManager->CreateNtupleDColumn(4, "px");
-    analysisManager->CreateNtupleDColumn(4, "py");
-    analysisManager->CreateNtupleDColumn(4, "pz");
-    analysisManager->CreateNtupleDColumn(4, "energy");
-    analysisManager->CreateNtupleDColumn(4, "theta");
-    analysisManager->CreateNtupleDColumn(4, "fluence");
-    analysisManager->FinishNtuple(4);
+    if (eventLayout) CreateEventNtuple(4, "BdxEvents", "Bdx", bdxColumns, kBdxColumnsPerDetector, true);
+    else CreateFlatNtuple(4, "Bdx", "eventid", bdxColumns, kBdxColumnsPerDetector);
+
+    analysisManager->CreateNtuple("Processes", "Processes");
+    analysisManager->CreateNtupleIColumn(5, "procid");
+    analysisManager->CreateNtupleSColumn(5, "name");
+    analysisManager->FinishNtuple(5);
+
+    // Muon ancestry and plane crossings, filled only with /muons/truth
+    analysisManager->CreateNtuple("MuonTruth", "MuonTruth");
+    analysisManager->CreateNtupleIColumn(6, "evid");
+    analysisManager->CreateNtupleIColumn(6, "trackid");
+    analysisManager->CreateNtupleIColumn(6, "parentid");
+    analysisManager->CreateNtupleIColumn(6, "pdg");
+    analysisManager->CreateNtupleIColumn(6, "procid");
+    analysisManager->CreateNtupleSColumn(6, "volume");
+    analysisManager->CreateNtupleDColumn(6, "vtxx");
+    analysisManager->CreateNtupleDColumn(6, "vtxy");
+    analysisManager->CreateNtupleDColumn(6, "vtxz");
+    analysisManager->CreateNtupleDColumn(6, "energy");
+    analysisManager->CreateNtupleDColumn(6, "weight");
+    analysisManager->FinishNtuple(6);
+
+    analysisManager->CreateNtuple("MuonPlanes", "MuonPlanes");
+    analysisManager->CreateNtupleIColumn(7, "evid");
+    analysisManager->CreateNtupleIColumn(7, "trackid");
+    analysisManager->CreateNtupleIColumn(7, "plane");
+    analysisManager->CreateNtupleDColumn(7, "x");
+    analysisManager->CreateNtupleDColumn(7, "y");
+    analysisManager->CreateNtupleDColumn(7, "z");
+    analysisManager->CreateNtupleDColumn(7, "px");
+    analysisManager->CreateNtupleDColumn(7, "py");
+    analysisManager->CreateNtupleDColumn(7, "pz");
+    analysisManager->CreateNtupleDColumn(7, "energy");
+    analysisManager->FinishNtuple(7);
+
+    analysisManager->CreateNtuple("Formats", "Formats");
+    analysisManager->CreateNtupleSColumn(8, "ntuple");
+    analysisManager->CreateNtupleSColumn(8, "column");
+    analysisManager->CreateNtupleSColumn(8, "storage");
+    analysisManager->CreateNtupleDColumn(8, "scale");
+    analysisManager->FinishNtuple(8);
+
+    // Process IDs for this run; the master writes their names once
+    ProcessRegistry* processRegistry = ProcessRegistry::Instance();
+    processRegistry->Build();
+    if (IsMaster() && outputManager->IsWriting()) processRegistry->Fill(5);
+    outputManager->FillColumnFormats(8);
+
+    // Event rows go through the output stage from here on
+    outputManager->BeginOfRun();
 
     return;
 }
 
-void RunAction::EndOfRunAction(const G4Run*) {
+void RunAction::EndOfRunAction(const G4Run* aRun) {
+
+    // The writer thread, if any, finishes before the file is written and closed
+    OutputManager::Instance()->EndOfRun();
+
+    // Workers hand over their remaining records before the master closes the file
+    PhaseSpaceWriter* phaseSpaceWriter = PhaseSpaceWriter::Instance();
+    phaseSpaceWriter->Flush();
+    if (IsMaster()) phaseSpaceWriter->Close();
+
+    SeedStore* seedStore = SeedStore::Instance();
+    seedStore->Flush();
+    if (IsMaster()) seedStore->Close();
 
-    G4RootAnalysisManager* analysisManager = G4RootAnalysisManager::Instance();
+    // Workers add their scores to the totals before the master writes them
+    for (std::size_t ii = 0; ii < fScorers.size(); ++ii) {
+        fScorers[ii]->Merge();
+        if (IsMaster()) fScorers[ii]->Write(aRun->GetNumberOfEvent());
+    }
 
-    analysisManager->Write();
-    analysisManager->CloseFile();
+    // Tallies of the workers are added to the master's
+    G4AccumulableManager::Instance()->Merge();
+    if (IsMaster()) ConvergenceMonitor::Instance()->Report(fTallies);
 
     return;
 }
\ No newline at end of file
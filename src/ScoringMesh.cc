@@ -0,0 +1,223 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ScoringMesh class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "ScoringMesh.hh"
+#include "OutputManager.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4Material.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleTable.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace {
+    const char* quantityNames[3] = {"edep", "dose", "fluence"};
+    const char* quantityUnits[3] = {"MeV", "Gy", "1/cm2"};
+}
+
+ScoringMesh::ScoringMesh(const G4String& name) : fName(name), fCentre(0., 0., 0.), fHalfSize(1.*m, 1.*m, 1.*m),
+                        fQuantity(kMeshEdep), fParticleName("all"), fVolumeName("all"), fScale(1.),
+                        fParticle(0), fVolume(0) {
+    fBins[0] = fBins[1] = fBins[2] = 1;
+}
+
+ScoringMesh::~ScoringMesh()
+{}
+
+void ScoringMesh::BeginOfRun() {
+
+    fLower = fCentre - fHalfSize;
+    fVoxelSize.set(2.*fHalfSize.x()/fBins[0], 2.*fHalfSize.y()/fBins[1], 2.*fHalfSize.z()/fBins[2]);
+    G4double voxelVolume = fVoxelSize.x()*fVoxelSize.y()*fVoxelSize.z();
+
+    // Dose is divided by the density of each step's material when scored
+    if (fQuantity == kMeshEdep) fScale = 1./MeV;
+    if (fQuantity == kMeshDose) fScale = 1./voxelVolume/gray;
+    if (fQuantity == kMeshFluence) fScale = cm2/voxelVolume;
+
+    fParticle = 0;
+    if (fParticleName != "all") {
+        fParticle = G4ParticleTable::GetParticleTable()->FindParticle(fParticleName);
+        if (!fParticle) {
+            G4ExceptionDescription msg;
+            msg << "Mesh " << fName << ": unknown particle " << fParticleName << "; scoring all particles.";
+            G4Exception("ScoringMesh::BeginOfRun", "Apollon016", JustWarning, msg);
+        }
+    }
+
+    fVolume = 0;
+    if (fVolumeName != "all") {
+        fVolume = G4LogicalVolumeStore::GetInstance()->GetVolume(fVolumeName, false, true);
+        if (!fVolume) {
+            G4ExceptionDescription msg;
+            msg << "Mesh " << fName << ": unknown logical volume " << fVolumeName << "; scoring in all volumes.";
+            G4Exception("ScoringMesh::BeginOfRun", "Apollon016", JustWarning, msg);
+        }
+    }
+
+    fScores.Resize(static_cast<std::size_t>(fBins[0])*fBins[1]*fBins[2]);
+}
+
+void ScoringMesh::ResetLocal() {
+    fScores.ResetLocal();
+}
+
+void ScoringMesh::Merge() {
+    fScores.Merge();
+}
+
+void ScoringMesh::Score(const G4Step* aStep) const {
+
+    const G4StepPoint* preStepPoint = aStep->GetPreStepPoint();
+    const G4Track* track = aStep->GetTrack();
+    if (fParticle && track->GetParticleDefinition() != fParticle) return;
+    if (fVolume && preStepPoint->GetPhysicalVolume()->GetLogicalVolume() != fVolume) return;
+
+    G4double weight = preStepPoint->GetWeight();
+
+    if (fQuantity == kMeshFluence) {
+        ScoreTrackLength(aStep, weight);
+        return;
+    }
+
+    G4double edep = aStep->GetTotalEnergyDeposit();
+    if (edep == 0.) return;
+
+    // Deposit scored at the step midpoint
+    G4ThreeVector point = 0.5*(preStepPoint->GetPosition() + aStep->GetPostStepPoint()->GetPosition()) - fLower;
+    G4int ix = static_cast<G4int>(std::floor(point.x()/fVoxelSize.x()));
+    G4int iy = static_cast<G4int>(std::floor(point.y()/fVoxelSize.y()));
+    G4int iz = static_cast<G4int>(std::floor(point.z()/fVoxelSize.z()));
+    if (ix < 0 || ix >= fBins[0] || iy < 0 || iy >= fBins[1] || iz < 0 || iz >= fBins[2]) return;
+
+    G4double value = edep*weight*fScale;
+    if (fQuantity == kMeshDose) value /= preStepPoint->GetMaterial()->GetDensity();
+    fScores.Add((static_cast<std::size_t>(ix)*fBins[1] + iy)*fBins[2] + iz, value);
+}
+
+void ScoringMesh::ScoreTrackLength(const G4Step* aStep, G4double weight) const {
+
+    // The step is taken as straight between its end points and its length
+    // shared among the voxels it passes through (3D DDA traversal)
+    G4ThreeVector start = aStep->GetPreStepPoint()->GetPosition() - fLower;
+    G4ThreeVector delta = aStep->GetPostStepPoint()->GetPosition() - aStep->GetPreStepPoint()->GetPosition();
+    G4double value = aStep->GetStepLength()*weight*fScale;
+    if (value == 0.) return;
+
+    const G4double infinity = std::numeric_limits<G4double>::infinity();
+    G4double startCoord[3] = {start.x(), start.y(), start.z()};
+    G4double deltaCoord[3] = {delta.x(), delta.y(), delta.z()};
+    G4double size[3] = {fVoxelSize.x(), fVoxelSize.y(), fVoxelSize.z()};
+
+    // Clip the segment, parametrised by t in [0, 1], to the mesh box
+    G4double tEnter = 0.;
+    G4double tExit = 1.;
+    for (G4int aa = 0; aa < 3; ++aa) {
+        G4double upper = size[aa]*fBins[aa];
+        if (deltaCoord[aa] == 0.) {
+            if (startCoord[aa] < 0. || startCoord[aa] >= upper) return;
+            continue;
+        }
+        G4double t1 = -startCoord[aa]/deltaCoord[aa];
+        G4double t2 = (upper - startCoord[aa])/deltaCoord[aa];
+        if (t1 > t2) std::swap(t1, t2);
+        if (t1 > tEnter) tEnter = t1;
+        if (t2 < tExit) tExit = t2;
+    }
+    if (tEnter >= tExit) return;
+
+    G4int index[3];
+    G4int step[3];
+    G4double tNext[3];
+    G4double tDelta[3];
+    for (G4int aa = 0; aa < 3; ++aa) {
+        G4int ii = static_cast<G4int>(std::floor((startCoord[aa] + tEnter*deltaCoord[aa])/size[aa]));
+        index[aa] = std::min(std::max(ii, 0), fBins[aa] - 1);
+        if (deltaCoord[aa] > 0.) {
+            step[aa] = 1;
+            tNext[aa] = ((index[aa] + 1)*size[aa] - startCoord[aa])/deltaCoord[aa];
+            tDelta[aa] = size[aa]/deltaCoord[aa];
+        }
+        else if (deltaCoord[aa] < 0.) {
+            step[aa] = -1;
+            tNext[aa] = (index[aa]*size[aa] - startCoord[aa])/deltaCoord[aa];
+            tDelta[aa] = -size[aa]/deltaCoord[aa];
+        }
+        else {
+            step[aa] = 0;
+            tNext[aa] = infinity;
+            tDelta[aa] = infinity;
+        }
+    }
+
+    G4double* scores = fScores.GetLocal();
+    G4double tt = tEnter;
+    while (tt < tExit) {
+        G4int axis = (tNext[0] < tNext[1]) ? ((tNext[0] < tNext[2]) ? 0 : 2) : ((tNext[1] < tNext[2]) ? 1 : 2);
+        G4double tEnd = std::min(tNext[axis], tExit);
+        scores[(static_cast<std::size_t>(index[0])*fBins[1] + index[1])*fBins[2] + index[2]] += (tEnd - tt)*value;
+        tt = tEnd;
+
+        index[axis] += step[axis];
+        if (index[axis] < 0 || index[axis] >= fBins[axis]) break;
+        tNext[axis] += tDelta[axis];
+    }
+}
+
+void ScoringMesh::Write(G4int nEvents) const {
+
+    ScoreFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.rank = 3;
+    G4ThreeVector upper = fCentre + fHalfSize;
+    G4double lower[3] = {fLower.x(), fLower.y(), fLower.z()};
+    G4double upperCoord[3] = {upper.x(), upper.y(), upper.z()};
+    for (G4int aa = 0; aa < 3; ++aa) {
+        header.shape[aa] = fBins[aa];
+        header.lower[aa] = lower[aa]/mm;
+        header.upper[aa] = upperCoord[aa]/mm;
+    }
+    header.nEvents = nEvents;
+    std::strncpy(header.quantity, quantityNames[fQuantity], sizeof(header.quantity) - 1);
+    std::strncpy(header.unit, quantityUnits[fQuantity], sizeof(header.unit) - 1);
+
+    G4String fname = OutputManager::Instance()->GetRunFileName(fName + ".score");
+    if (fScores.Write(fname, header)) {
+        G4cout << "Mesh " << fName << " written to " << fname << "." << G4endl;
+    }
+}
+
+void ScoringMesh::SetHalfSize(G4ThreeVector size) { fHalfSize = size; }
+void ScoringMesh::SetCentre(G4ThreeVector centre) { fCentre = centre; }
+void ScoringMesh::SetBins(G4int nx, G4int ny, G4int nz) { fBins[0] = nx; fBins[1] = ny; fBins[2] = nz; }
+void ScoringMesh::SetParticle(const G4String& name) { fParticleName = name; }
+void ScoringMesh::SetVolume(const G4String& name) { fVolumeName = name; }
+
+void ScoringMesh::SetQuantity(const G4String& quantity) {
+    if (quantity == "edep") fQuantity = kMeshEdep;
+    if (quantity == "dose") fQuantity = kMeshDose;
+    if (quantity == "fluence") fQuantity = kMeshFluence;
+}
+
+void ScoringMesh::Print() const {
+
+    G4cout << "Mesh " << fName << ": " << quantityNames[fQuantity]
+           << ", centre " << fCentre/mm << " mm, half size " << fHalfSize/mm << " mm, "
+           << fBins[0] << " x " << fBins[1] << " x " << fBins[2] << " bins, particle " << fParticleName
+           << ", volume " << fVolumeName << G4endl;
+}
@@ -0,0 +1,72 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ScoringMeshManager class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <algorithm>
+
+#include "ScoringMeshManager.hh"
+#include "ScoringMeshMessenger.hh"
+#include "ScoringMesh.hh"
+
+ScoringMeshManager* ScoringMeshManager::Instance() {
+    static ScoringMeshManager theManager;
+    return &theManager;
+}
+
+ScoringMeshManager::ScoringMeshManager() : fMessenger(0) {
+    fMessenger = new ScoringMeshMessenger(this);
+}
+
+ScoringMeshManager::~ScoringMeshManager() {
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) delete fMeshes[ii];
+    delete fMessenger;
+}
+
+ScoringMesh* ScoringMeshManager::CreateMesh(const G4String& name) {
+
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) {
+        if (fMeshes[ii]->GetName() == name) {
+            G4ExceptionDescription msg;
+            msg << "Mesh " << name << " already exists; its settings will be changed instead.";
+            G4Exception("ScoringMeshManager::CreateMesh", "Apollon017", JustWarning, msg);
+            std::swap(fMeshes[ii], fMeshes.back());
+            return fMeshes.back();
+        }
+    }
+    fMeshes.push_back(new ScoringMesh(name));
+    return fMeshes.back();
+}
+
+ScoringMesh* ScoringMeshManager::GetCurrentMesh() const {
+    return fMeshes.empty() ? 0 : fMeshes.back();
+}
+
+void ScoringMeshManager::BeginOfRun() {
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) fMeshes[ii]->BeginOfRun();
+}
+
+void ScoringMeshManager::ResetLocal() {
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) fMeshes[ii]->ResetLocal();
+}
+
+void ScoringMeshManager::Merge() {
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) fMeshes[ii]->Merge();
+}
+
+void ScoringMeshManager::Write(G4int nEvents) const {
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) fMeshes[ii]->Write(nEvents);
+}
+
+void ScoringMeshManager::Score(const G4Step* aStep) const {
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) fMeshes[ii]->Score(aStep);
+}
+
+void ScoringMeshManager::List() const {
+    if (fMeshes.empty()) G4cout << "No scoring meshes defined." << G4endl;
+    for (std::size_t ii = 0; ii < fMeshes.size(); ++ii) fMeshes[ii]->Print();
+}
@@ -0,0 +1,130 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ScoringMeshMessenger class
+// Last edited: 17/10/2026
+//
+
+#include <sstream>
+
+#include "ScoringMeshMessenger.hh"
+#include "ScoringMeshManager.hh"
+#include "ScoringMesh.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+ScoringMeshMessenger::ScoringMeshMessenger(ScoringMeshManager* manager) : G4UImessenger(), fManager(manager) {
+
+    fDirectory = new G4UIdirectory("/mesh/");
+    fDirectory->SetGuidance("Box meshes scoring energy deposit, dose or fluence, written at the end of each run.");
+    fDirectory->SetGuidance("Commands other than create apply to the mesh created last.");
+
+    fCreateCmd = new G4UIcmdWithAString("/mesh/create", this);
+    fCreateCmd->SetGuidance("Create a mesh; its scores are written to <name>.score.");
+    fCreateCmd->SetParameterName("name", false);
+    fCreateCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fCreateCmd->SetToBeBroadcasted(false);
+
+    fSizeCmd = new G4UIcmdWith3VectorAndUnit("/mesh/size", this);
+    fSizeCmd->SetGuidance("Set the half-lengths of the mesh box.");
+    fSizeCmd->SetParameterName("hx", "hy", "hz", false);
+    fSizeCmd->SetRange("hx>0. && hy>0. && hz>0.");
+    fSizeCmd->SetUnitCategory("Length");
+    fSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fSizeCmd->SetToBeBroadcasted(false);
+
+    fPositionCmd = new G4UIcmdWith3VectorAndUnit("/mesh/position", this);
+    fPositionCmd->SetGuidance("Set the centre of the mesh box in the world frame.");
+    fPositionCmd->SetParameterName("x", "y", "z", false);
+    fPositionCmd->SetUnitCategory("Length");
+    fPositionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPositionCmd->SetToBeBroadcasted(false);
+
+    fBinsCmd = new G4UIcommand("/mesh/bins", this);
+    fBinsCmd->SetGuidance("Set the number of bins along x, y and z.");
+    G4UIparameter* nx = new G4UIparameter("nx", 'i', false);
+    nx->SetParameterRange("nx>0");
+    fBinsCmd->SetParameter(nx);
+    G4UIparameter* ny = new G4UIparameter("ny", 'i', false);
+    ny->SetParameterRange("ny>0");
+    fBinsCmd->SetParameter(ny);
+    G4UIparameter* nz = new G4UIparameter("nz", 'i', false);
+    nz->SetParameterRange("nz>0");
+    fBinsCmd->SetParameter(nz);
+    fBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fBinsCmd->SetToBeBroadcasted(false);
+
+    fQuantityCmd = new G4UIcmdWithAString("/mesh/quantity", this);
+    fQuantityCmd->SetGuidance("Set the scored quantity: edep (MeV), dose (Gy) or fluence (track length per volume, 1/cm2).");
+    fQuantityCmd->SetParameterName("quantity", false);
+    fQuantityCmd->SetCandidates("edep dose fluence");
+    fQuantityCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fQuantityCmd->SetToBeBroadcasted(false);
+
+    fParticleCmd = new G4UIcmdWithAString("/mesh/particle", this);
+    fParticleCmd->SetGuidance("Score only this particle (e.g. mu-), or all particles.");
+    fParticleCmd->SetParameterName("particle", false);
+    fParticleCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fParticleCmd->SetToBeBroadcasted(false);
+
+    fVolumeCmd = new G4UIcmdWithAString("/mesh/volume", this);
+    fVolumeCmd->SetGuidance("Score only in this logical volume (e.g. lLeadWallFront), or in all volumes.");
+    fVolumeCmd->SetParameterName("volume", false);
+    fVolumeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fVolumeCmd->SetToBeBroadcasted(false);
+
+    fListCmd = new G4UIcmdWithoutParameter("/mesh/list", this);
+    fListCmd->SetGuidance("List the defined meshes.");
+    fListCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fListCmd->SetToBeBroadcasted(false);
+}
+
+ScoringMeshMessenger::~ScoringMeshMessenger() {
+    delete fDirectory;
+    delete fCreateCmd;
+    delete fSizeCmd;
+    delete fPositionCmd;
+    delete fBinsCmd;
+    delete fQuantityCmd;
+    delete fParticleCmd;
+    delete fVolumeCmd;
+    delete fListCmd;
+}
+
+void ScoringMeshMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fCreateCmd) {
+        fManager->CreateMesh(newValue);
+        return;
+    }
+    if (command == fListCmd) {
+        fManager->List();
+        return;
+    }
+
+    ScoringMesh* mesh = fManager->GetCurrentMesh();
+    if (!mesh) {
+        G4Exception("ScoringMeshMessenger::SetNewValue", "Apollon018", JustWarning,
+                    "No mesh defined; use /mesh/create first.");
+        return;
+    }
+
+    if (command == fSizeCmd) mesh->SetHalfSize(fSizeCmd->GetNew3VectorValue(newValue));
+    if (command == fPositionCmd) mesh->SetCentre(fPositionCmd->GetNew3VectorValue(newValue));
+    if (command == fBinsCmd) {
+        std::istringstream iss(newValue);
+        G4int nx, ny, nz;
+        iss >> nx >> ny >> nz;
+        mesh->SetBins(nx, ny, nz);
+    }
+    if (command == fQuantityCmd) mesh->SetQuantity(newValue);
+    if (command == fParticleCmd) mesh->SetParticle(newValue);
+    if (command == fVolumeCmd) mesh->SetVolume(newValue);
+
+}
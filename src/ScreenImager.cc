@@ -0,0 +1,148 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ScreenImager class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cmath>
+#include <cstring>
+
+#include "ScreenImager.hh"
+#include "ScreenImagerMessenger.hh"
+#include "OutputManager.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4Box.hh"
+#include "G4SystemOfUnits.hh"
+
+ScreenImager* ScreenImager::Instance() {
+    static ScreenImager theImager;
+    return &theImager;
+}
+
+ScreenImager::ScreenImager() : fMessenger(0), fEnabled(false) {
+
+    // 0.2 mm pixels on the YAG screens, 0.5 mm on the LANEX phosphor
+    fPixels["lYagScreen"] = std::make_pair(500, 152);
+    fPixels["lPhosphorLayer"] = std::make_pair(600, 300);
+
+    fMessenger = new ScreenImagerMessenger(this);
+}
+
+ScreenImager::~ScreenImager() {
+    ClearScreens();
+    delete fMessenger;
+}
+
+void ScreenImager::ClearScreens() {
+    for (std::size_t ii = 0; ii < fScreens.size(); ++ii) delete fScreens[ii];
+    fScreens.clear();
+    fSlots.clear();
+}
+
+void ScreenImager::BeginOfRun() {
+
+    ClearScreens();
+    if (!fEnabled) return;
+
+    // One screen per placement of an imaged box volume
+    const G4PhysicalVolumeStore* store = G4PhysicalVolumeStore::GetInstance();
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        const G4VPhysicalVolume* volume = (*store)[ii];
+        const G4LogicalVolume* logical = volume->GetLogicalVolume();
+        std::map<G4String, std::pair<G4int, G4int> >::const_iterator it = fPixels.find(logical->GetName());
+        if (it == fPixels.end()) continue;
+
+        const G4Box* box = dynamic_cast<const G4Box*>(logical->GetSolid());
+        if (!box) {
+            G4ExceptionDescription msg;
+            msg << "Screen " << volume->GetName() << " is not a box and cannot be imaged.";
+            G4Exception("ScreenImager::BeginOfRun", "Apollon019", JustWarning, msg);
+            continue;
+        }
+
+        Screen* screen = new Screen();
+        screen->name = volume->GetName();
+        screen->nx = it->second.first;
+        screen->ny = it->second.second;
+        screen->halfX = box->GetXHalfLength();
+        screen->halfY = box->GetYHalfLength();
+        screen->image.Resize(static_cast<std::size_t>(screen->nx)*screen->ny);
+
+        std::size_t index = volume->GetInstanceID();
+        if (index >= fSlots.size()) fSlots.resize(index + 1, -1);
+        fSlots[index] = fScreens.size();
+        fScreens.push_back(screen);
+    }
+}
+
+void ScreenImager::ResetLocal() {
+    for (std::size_t ii = 0; ii < fScreens.size(); ++ii) fScreens[ii]->image.ResetLocal();
+}
+
+void ScreenImager::Merge() {
+    for (std::size_t ii = 0; ii < fScreens.size(); ++ii) fScreens[ii]->image.Merge();
+}
+
+void ScreenImager::Score(const G4Step* aStep) const {
+
+    const G4StepPoint* preStepPoint = aStep->GetPreStepPoint();
+    std::size_t index = preStepPoint->GetPhysicalVolume()->GetInstanceID();
+    if (index >= fSlots.size() || fSlots[index] < 0) return;
+
+    G4double edep = aStep->GetTotalEnergyDeposit();
+    if (edep == 0.) return;
+
+    // Deposit placed at the step midpoint, in the screen frame
+    const Screen* screen = fScreens[fSlots[index]];
+    G4ThreeVector midPoint = 0.5*(preStepPoint->GetPosition() + aStep->GetPostStepPoint()->GetPosition());
+    G4ThreeVector local = preStepPoint->GetTouchable()->GetHistory()->GetTopTransform().TransformPoint(midPoint);
+
+    G4int ix = static_cast<G4int>(std::floor((local.x() + screen->halfX)/(2.*screen->halfX)*screen->nx));
+    G4int iy = static_cast<G4int>(std::floor((local.y() + screen->halfY)/(2.*screen->halfY)*screen->ny));
+    if (ix < 0 || ix >= screen->nx || iy < 0 || iy >= screen->ny) return;
+
+    screen->image.Add(static_cast<std::size_t>(iy)*screen->nx + ix, edep*preStepPoint->GetWeight()/MeV);
+}
+
+void ScreenImager::Write(G4int nEvents) const {
+
+    for (std::size_t ii = 0; ii < fScreens.size(); ++ii) {
+        const Screen* screen = fScreens[ii];
+
+        ScoreFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.rank = 2;
+        header.shape[0] = screen->ny;
+        header.shape[1] = screen->nx;
+        header.lower[0] = -screen->halfY/mm;
+        header.upper[0] = screen->halfY/mm;
+        header.lower[1] = -screen->halfX/mm;
+        header.upper[1] = screen->halfX/mm;
+        header.nEvents = nEvents;
+        std::strncpy(header.quantity, "edep", sizeof(header.quantity) - 1);
+        std::strncpy(header.unit, "MeV", sizeof(header.unit) - 1);
+
+        G4String fname = OutputManager::Instance()->GetRunFileName("image_" + screen->name + ".score");
+        if (screen->image.Write(fname, header)) {
+            G4cout << "Screen image " << fname << " written (" << screen->nx << " x " << screen->ny
+                   << " pixels)." << G4endl;
+        }
+    }
+}
+
+void ScreenImager::SetEnabled(G4bool val) { fEnabled = val; }
+
+void ScreenImager::SetPixels(const G4String& volume, G4int nx, G4int ny) {
+    fPixels[volume] = std::make_pair(nx, ny);
+}
@@ -0,0 +1,61 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for ScreenImagerMessenger class
+// Last edited: 17/10/2026
+//
+
+#include <sstream>
+
+#include "ScreenImagerMessenger.hh"
+#include "ScreenImager.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+
+ScreenImagerMessenger::ScreenImagerMessenger(ScreenImager* imager) : G4UImessenger(), fImager(imager) {
+
+    fDirectory = new G4UIdirectory("/screens/");
+    fDirectory->SetGuidance("Energy-deposit images of the YAG and LANEX screens.");
+
+    fImageCmd = new G4UIcmdWithABool("/screens/image", this);
+    fImageCmd->SetGuidance("Accumulate screen images, written to image_<screen>.score at the end of each run.");
+    fImageCmd->SetParameterName("image", false);
+    fImageCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fImageCmd->SetToBeBroadcasted(false);
+
+    fPixelsCmd = new G4UIcommand("/screens/pixels", this);
+    fPixelsCmd->SetGuidance("Set the pixel grid over the x-y face of a screen volume (adds the volume if new).");
+    G4UIparameter* volume = new G4UIparameter("volume", 's', false);
+    fPixelsCmd->SetParameter(volume);
+    G4UIparameter* nx = new G4UIparameter("nx", 'i', false);
+    nx->SetParameterRange("nx>0");
+    fPixelsCmd->SetParameter(nx);
+    G4UIparameter* ny = new G4UIparameter("ny", 'i', false);
+    ny->SetParameterRange("ny>0");
+    fPixelsCmd->SetParameter(ny);
+    fPixelsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPixelsCmd->SetToBeBroadcasted(false);
+}
+
+ScreenImagerMessenger::~ScreenImagerMessenger() {
+    delete fDirectory;
+    delete fImageCmd;
+    delete fPixelsCmd;
+}
+
+void ScreenImagerMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fImageCmd) fImager->SetEnabled(fImageCmd->GetNewBoolValue(newValue));
+    if (command == fPixelsCmd) {
+        std::istringstream iss(newValue);
+        G4String volume;
+        G4int nx, ny;
+        iss >> volume >> nx >> ny;
+        fImager->SetPixels(volume, nx, ny);
+    }
+
+}
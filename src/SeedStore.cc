@@ -0,0 +1,205 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for SeedStore class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <algorithm>
+#include <cstring>
+
+#include "SeedStore.hh"
+#include "SeedStoreMessenger.hh"
+#include "OutputManager.hh"
+
+#include "G4Event.hh"
+#include "G4AutoLock.hh"
+#include "Randomize.hh"
+
+namespace {
+    G4Mutex storeMutex = G4MUTEX_INITIALIZER;
+
+    const std::size_t kBufferSize = 4096;
+    G4ThreadLocal std::vector<SeedRecord>* threadBuffer = 0;
+    // Record of the event being processed on this thread, set at its first event
+    G4ThreadLocal SeedRecord threadRecord;
+    G4ThreadLocal SeedRecord* currentRecord = 0;
+
+    G4bool EarlierEvent(const SeedRecord& lhs, const SeedRecord& rhs) { return lhs.evid < rhs.evid; }
+}
+
+SeedStore* SeedStore::Instance() {
+    static SeedStore theStore;
+    return &theStore;
+}
+
+SeedStore::SeedStore() : fMessenger(0), fEnabled(false), fFileName("apollon_seeds_run{run}.bin"), fRunFileName(""),
+                         fFile(0), fNRecords(0), fReplayMask(kMuonCreated) {
+    fMessenger = new SeedStoreMessenger(this);
+}
+
+SeedStore::~SeedStore() {
+    Close();
+    for (std::size_t ii = 0; ii < fBuffers.size(); ++ii) delete fBuffers[ii];
+    delete fMessenger;
+}
+
+void SeedStore::Open() {
+
+    // A replay run does not overwrite the store it is reading from
+    if (!fEnabled || fFile || IsReplaying()) return;
+
+    fRunFileName = OutputManager::Instance()->ExpandFileName(fFileName);
+    fFile = std::fopen(fRunFileName.c_str(), "wb");
+    if (!fFile) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open seed store " << fRunFileName << "; seeds will not be recorded for this run.";
+        G4Exception("SeedStore::Open", "Apollon011", JustWarning, msg);
+        return;
+    }
+    fNRecords = 0;
+    WriteHeader();
+}
+
+void SeedStore::Close() {
+
+    if (!fFile) return;
+
+    std::fseek(fFile, 0, SEEK_SET);
+    WriteHeader();
+    std::fclose(fFile);
+    fFile = 0;
+
+    G4cout << "Seed store " << fRunFileName << " written: " << fNRecords << " events." << G4endl;
+}
+
+void SeedStore::WriteHeader() {
+
+    PhaseSpaceHeader header;
+    std::memcpy(header.magic, kSeedStoreMagic, sizeof(kSeedStoreMagic));
+    header.version = kSeedStoreVersion;
+    header.recordSize = sizeof(SeedRecord);
+    header.nRecords = fNRecords;
+    header.reserved = 0;
+    std::fwrite(&header, sizeof(header), 1, fFile);
+}
+
+void SeedStore::BeginEvent(G4Event* anEvent) {
+
+    if (!currentRecord) currentRecord = &threadRecord;
+
+    // The engine is restarted from two seeds per event, so that the whole
+    // event can later be reproduced from those seeds alone.
+    long seeds[3] = {0, 0, 0};
+    if (IsReplaying()) {
+        G4int index = anEvent->GetEventID();
+        if (index >= static_cast<G4int>(fReplay.size())) {
+            G4ExceptionDescription msg;
+            msg << "Event " << index << " is beyond the " << fReplay.size() << " events selected for replay.";
+            G4Exception("SeedStore::BeginEvent", "Apollon012", EventMustBeAborted, msg);
+            return;
+        }
+        *currentRecord = fReplay[index];
+        anEvent->SetEventID(currentRecord->evid);
+        seeds[0] = currentRecord->seeds[0];
+        seeds[1] = currentRecord->seeds[1];
+    }
+    else if (IsRecording()) {
+        // Seeds follow from the engine state set by the run manager for this event
+        for (G4int ii = 0; ii < 2; ++ii) {
+            seeds[ii] = 1 + static_cast<long>(2147483646.*G4UniformRand());
+        }
+        currentRecord->evid = anEvent->GetEventID();
+        currentRecord->flags = 0;
+        currentRecord->seeds[0] = seeds[0];
+        currentRecord->seeds[1] = seeds[1];
+        currentRecord->psIndex = 0;
+    }
+    else {
+        return;
+    }
+    G4Random::setTheSeeds(seeds);
+}
+
+void SeedStore::EndEvent(G4int evid, uint32_t flags) {
+
+    if (!IsRecording() || !currentRecord || currentRecord->evid != evid) return;
+
+    currentRecord->flags = flags;
+    if (!threadBuffer) {
+        threadBuffer = new std::vector<SeedRecord>();
+        threadBuffer->reserve(kBufferSize);
+        G4AutoLock lock(&storeMutex);
+        fBuffers.push_back(threadBuffer);
+    }
+    threadBuffer->push_back(*currentRecord);
+    if (threadBuffer->size() >= kBufferSize) Flush();
+}
+
+void SeedStore::Flush() {
+
+    if (!threadBuffer || threadBuffer->empty()) return;
+
+    G4AutoLock lock(&storeMutex);
+    if (fFile) {
+        std::fwrite(threadBuffer->data(), sizeof(SeedRecord), threadBuffer->size(), fFile);
+        fNRecords += threadBuffer->size();
+    }
+    lock.unlock();
+
+    threadBuffer->clear();
+}
+
+uint64_t SeedStore::GetPhaseSpaceIndex() const {
+    return currentRecord ? currentRecord->psIndex : 0;
+}
+
+void SeedStore::SetPhaseSpaceIndex(uint64_t index) {
+    if (currentRecord) currentRecord->psIndex = index;
+}
+
+void SeedStore::LoadReplay(const G4String& fname) {
+
+    fReplay.clear();
+    if (fname == "none") return;
+
+    std::FILE* infile = std::fopen(fname.c_str(), "rb");
+    if (!infile) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open seed store " << fname << "; replay disabled.";
+        G4Exception("SeedStore::LoadReplay", "Apollon013", JustWarning, msg);
+        return;
+    }
+
+    PhaseSpaceHeader header;
+    if (std::fread(&header, sizeof(header), 1, infile) != 1
+        || std::memcmp(header.magic, kSeedStoreMagic, sizeof(kSeedStoreMagic)) != 0
+        || header.recordSize != sizeof(SeedRecord)) {
+        std::fclose(infile);
+        G4ExceptionDescription msg;
+        msg << fname << " is not a seed store written by this program; replay disabled.";
+        G4Exception("SeedStore::LoadReplay", "Apollon014", JustWarning, msg);
+        return;
+    }
+
+    // Only the flagged events are kept, in event order
+    std::vector<SeedRecord> block(kBufferSize);
+    std::size_t nread = 0;
+    while ((nread = std::fread(block.data(), sizeof(SeedRecord), block.size(), infile)) > 0) {
+        for (std::size_t ii = 0; ii < nread; ++ii) {
+            if (block[ii].flags & fReplayMask) fReplay.push_back(block[ii]);
+        }
+    }
+    std::fclose(infile);
+    std::sort(fReplay.begin(), fReplay.end(), EarlierEvent);
+
+    G4cout << "Seed store " << fname << ": " << fReplay.size() << " of " << header.nRecords
+           << " events match flag mask " << fReplayMask << "." << G4endl
+           << "Use /run/beamOn " << fReplay.size() << " to replay them." << G4endl;
+}
+
+void SeedStore::SetRecording(G4bool val) { fEnabled = val; }
+void SeedStore::SetFileName(const G4String& fname) { fFileName = fname; }
+void SeedStore::SetReplayMask(G4int mask) { fReplayMask = mask; }
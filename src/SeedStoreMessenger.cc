@@ -0,0 +1,66 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for SeedStoreMessenger class
+// Last edited: 17/10/2026
+//
+
+#include "SeedStoreMessenger.hh"
+#include "SeedStore.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+SeedStoreMessenger::SeedStoreMessenger(SeedStore* store) : G4UImessenger(), fStore(store) {
+
+    fDirectory = new G4UIdirectory("/seeds/");
+    fDirectory->SetGuidance("Per-event random seeds, for replaying selected events with full output.");
+
+    fRecordCmd = new G4UIcmdWithABool("/seeds/record", this);
+    fRecordCmd->SetGuidance("Reseed every event and record its seeds and flags.");
+    fRecordCmd->SetParameterName("record", false);
+    fRecordCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fRecordCmd->SetToBeBroadcasted(false);
+
+    fFileNameCmd = new G4UIcmdWithAString("/seeds/fileName", this);
+    fFileNameCmd->SetGuidance("Set the seed store output file; {run}, {seed} and {name} are expanded as in /output/fileName.");
+    fFileNameCmd->SetParameterName("fileName", false);
+    fFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFileNameCmd->SetToBeBroadcasted(false);
+
+    fMaskCmd = new G4UIcmdWithAnInteger("/seeds/replayMask", this);
+    fMaskCmd->SetGuidance("Replay events having any of these flag bits set (1: muon created).");
+    fMaskCmd->SetGuidance("Must be given before /seeds/replay.");
+    fMaskCmd->SetParameterName("mask", false);
+    fMaskCmd->SetRange("mask > 0");
+    fMaskCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fMaskCmd->SetToBeBroadcasted(false);
+
+    fReplayCmd = new G4UIcmdWithAString("/seeds/replay", this);
+    fReplayCmd->SetGuidance("Replay the flagged events of a seed store with all tracks and trajectories kept.");
+    fReplayCmd->SetGuidance("Event n of the following run replays the n-th flagged event; \"none\" ends replay.");
+    fReplayCmd->SetParameterName("fileName", false);
+    fReplayCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fReplayCmd->SetToBeBroadcasted(false);
+}
+
+SeedStoreMessenger::~SeedStoreMessenger() {
+    delete fDirectory;
+    delete fRecordCmd;
+    delete fFileNameCmd;
+    delete fMaskCmd;
+    delete fReplayCmd;
+}
+
+void SeedStoreMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fRecordCmd) fStore->SetRecording(fRecordCmd->GetNewBoolValue(newValue));
+    if (command == fFileNameCmd) fStore->SetFileName(newValue);
+    if (command == fMaskCmd) fStore->SetReplayMask(fMaskCmd->GetNewIntValue(newValue));
+    if (command == fReplayCmd) fStore->LoadReplay(newValue);
+
+}
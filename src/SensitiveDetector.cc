@@ -3,23 +3,36 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Source file for SensitiveDetector class
-// Last edited: 07/02/2022
+// Last edited: 17/10/2026
 //
 
+#include <cmath>
+#include <cstdlib>
+
 #include "SensitiveDetector.hh"
+#include "DetectorIDTable.hh"
+#include "DetectorConstruction.hh"
+#include "ProcessRegistry.hh"
+#include "EventAction.hh"
+#include "OutputManager.hh"
+#include "OutputBatch.hh"
 
 #include "G4Step.hh"
 #include "G4Track.hh"
 #include "G4StepPoint.hh"
 #include "G4TouchableHistory.hh"
-#include "G4RootAnalysisManager.hh"
-#include "G4RunManager.hh"
+#include "G4EventManager.hh"
 #include "G4HCofThisEvent.hh"
 #include "G4SystemOfUnits.hh"
 
-SensitiveDetector::SensitiveDetector(G4String name) : G4VSensitiveDetector(name), fHitCollection(0), fBDXCollection(0),
-                 fHCID(0), fBXCID(0) {
+SensitiveDetector::SensitiveDetector(G4String name, const DetectorConstruction* detector, G4int summaryDetector) :
+                 G4VSensitiveDetector(name), fHitCapacity(0), fEventLayout(false), fDetector(detector),
+                 fDetectorIDs(detector->GetDetectorIDTable()), fEventAction(0), fSummaryDetector(summaryDetector),
+                 fBDXCollection(0),
+                 fHCID(-1), fBXCID(-1), fBDXCapacity(0), fHitMode(kHitPerStep),
+                 fRecordCrossings(true) {
     collectionName.insert("HitCollection");
+    collectionName.insert("BDXCollection");
 }
 
 SensitiveDetector::~SensitiveDetector()
@@ -27,15 +40,25 @@ SensitiveDetector::~SensitiveDetector()
 
 void SensitiveDetector::Initialize(G4HCofThisEvent* HCE) {
 
-    fHitCollection = new HitCollection(GetName(), collectionName[0]);
-	fHCID = -1;
+    // Collections are owned and deleted by the event; their storage is
+    // sized from the largest event so far to avoid regrowing
 	if (fHCID < 0) fHCID = GetCollectionID(0);
-	HCE->AddHitsCollection(fHCID, fHitCollection);
+    InitializeHits(HCE, fHCID);
 
-    fBDXCollection = new BDXCollection(GetName(), collectionName[0]);
-    fBXCID = -1;
-    if (fBXCID < 0) fBXCID = GetCollectionID(0);
+    fBDXCollection = new BDXCollection(GetName(), collectionName[1]);
+    fBDXCollection->GetVector()->reserve(fBDXCapacity);
+    if (fBXCID < 0) fBXCID = GetCollectionID(1);
     HCE->AddHitsCollection(fBXCID, fBDXCollection);
+
+    // Per-event summary is kept by this thread's event action
+    fEventAction = static_cast<EventAction*>(G4EventManager::GetEventManager()->GetUserEventAction());
+
+    // Aggregation settings may change between runs
+    fHitMode = fDetector->GetHitMode();
+    fVoxelSize = fDetector->GetVoxelSize();
+    fRecordCrossings = fDetector->GetRecordCrossings(GetName());
+    fHitMap.clear();
+    fEventLayout = OutputManager::Instance()->IsEventLayout();
     
 }
 
@@ -46,133 +69,224 @@ G4bool SensitiveDetector::ProcessHits(G4Step* aStep, G4TouchableHistory* aToucha
 
     // Get detector ID
     const G4VTouchable* theTouchable = preStepPoint->GetTouchable();
-    const G4String& logicName = theTouchable->GetVolume()->GetLogicalVolume()->GetName();
-    G4int ldet = 0;
-    G4int detidx = 0;
-    if (logicName == "lYagScreen") {
-        ldet = 1000;
-    }
-    else if (logicName == "lCr39") {
-        ldet = 2000;
-    }
-    else if (logicName == "lPhosphorLayer") {
-        ldet = 3000;
+    G4int ldet = fDetectorIDs->GetHitID(theTouchable->GetVolume()->GetLogicalVolume());
+    if (ldet == DetectorIDTable::kNoDetector) ldet = 0;
+    G4int detid = ldet + 100*(theTouchable->GetCopyNumber(1)) + theTouchable->GetCopyNumber();
+
+    if (fRecordCrossings && preStepPoint->GetStepStatus() == fGeomBoundary) RecordCrossing(aStep, detid);
+
+    // Energy deposition of hit
+    G4double edep = aStep->GetTotalEnergyDeposit();
+    if (edep == 0.) return false;
+
+    G4int species = kSummaryOther;
+    switch (std::abs(aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding())) {
+        case 13:   species = kSummaryMuon; break;
+        case 11:   species = kSummaryElectron; break;
+        case 2212: species = kSummaryProton; break;
+        default: break;
     }
-    else if (logicName == "lGSpecConverter") {
-        ldet = 4000;
+    G4int trackID = aStep->GetTrack()->GetTrackID();
+    fEventAction->AddDeposit(fSummaryDetector, species, trackID, edep);
+    // Each Cr-39 stack also has a summary of its own, keyed by its placement
+    if (fSummaryDetector == kSummaryCr39) {
+        G4int stack = fDetectorIDs->GetStack(theTouchable->GetVolume(1));
+        if (stack != DetectorIDTable::kNoDetector) {
+            fEventAction->AddDeposit(kNSummaryDetectors + stack, species, trackID, edep);
+        }
     }
-    G4int detid = ldet + 100*(theTouchable->GetCopyNumber(1)) + theTouchable->GetCopyNumber();
 
     // Position of hit
     G4ThreeVector prePosition = preStepPoint->GetPosition();
     G4ThreeVector postPosition = postStepPoint->GetPosition();
-    G4ThreeVector position = prePosition + G4UniformRand() * (postPosition - prePosition); // Energy deposition occurs at 
-                                                                                           // a random point along step.
-    
-    G4Track* track = aStep->GetTrack();
-    G4int trackid = track->GetTrackID();
-
-    // PDG code of particle causing hit
-    G4int pdgCode = track->GetParticleDefinition()->GetPDGEncoding();
-    
-    // Vertex position of track causing hit
-    G4ThreeVector vpos = track->GetVertexPosition();
-
-    // Total energy of particle depositing energy
-    G4double energy = track->GetTotalEnergy();
-
-     //
-    // Boundary crossing scoring 
-    //
-    if (preStepPoint->GetStepStatus() == fGeomBoundary) {
-        BDCrossing * aBdx = new BDCrossing();
-
-        // Getting volume information
-        G4ThreeVector localPosition = theTouchable->GetHistory()->GetTopTransform().TransformPoint(prePosition);
-        G4ThreeVector surfNorm = theTouchable->GetSolid()->SurfaceNormal(localPosition);
-        G4double areaS = 0.5*theTouchable->GetSolid()->GetSurfaceArea()/mm2;
-
-        // Creator process
-        G4int procid = 0;
-        if (track->GetCreatorProcess()) {
-            procid += track->GetCreatorProcess()->GetProcessSubType();
-        }
+    G4ThreeVector position;
+    if (fHitMode == kHitPerStep) {
+        position = prePosition + G4UniformRand() * (postPosition - prePosition); // Energy deposition occurs at 
+                                                                                 // a random point along step.
+        AddHit(aStep, detid, position, edep, aStep->GetTrack()->GetWeight());
+        return true;
+    }
+    position = 0.5*(prePosition + postPosition);    // merged hits use the step midpoint for their centroid
 
-        aBdx->SetPDG(pdgCode);
-        aBdx->SetDetID(detid);
-        aBdx->SetVertex(vpos);
-        aBdx->SetPosition(prePosition);
-        aBdx->SetEnergy(energy);
-        aBdx->SetMomentum(track->GetMomentum());
-        aBdx->SetAngle(surfNorm);
-        aBdx->SetFluence(surfNorm, areaS);
-        aBdx->SetCreatorProcess(procid);
-        fBDXCollection->insert(aBdx);
+    // Aggregated hits: the deposit is added to the hit with the same key.
+    // A voxel collects several tracks, so its hit holds the weighted energy
+    // and a weight of one; a track keeps its own weight.
+    G4double weight = aStep->GetTrack()->GetWeight();
+    HitKey key;
+    key.detid = detid;
+    if (fHitMode == kHitPerTrack) {
+        key.ii = aStep->GetTrack()->GetTrackID();
+        key.jj = 0;
+        key.kk = 0;
+    }
+    else {
+        key.ii = static_cast<G4int>(std::floor(position.x()/fVoxelSize.x()));
+        key.jj = static_cast<G4int>(std::floor(position.y()/fVoxelSize.y()));
+        key.kk = static_cast<G4int>(std::floor(position.z()/fVoxelSize.z()));
+        edep *= weight;
+        weight = 1.;
+    }
 
+    std::unordered_map<HitKey, std::size_t, HitKeyHash>::iterator it = fHitMap.find(key);
+    if (it != fHitMap.end()) {
+        MergeHit(it->second, aStep->GetTrack()->GetTrackID(), position, edep);
+    }
+    else {
+        fHitMap[key] = AddHit(aStep, detid, position, edep, weight);
     }
 
-    // Adding Hit information
-    // Energy deposition of hit
-    G4double edep = aStep->GetTotalEnergyDeposit();
-    if (edep == 0.) return false;
+    return true;
+}
+
+void SensitiveDetector::RecordCrossing(const G4Step* aStep, G4int detid) {
+
+    const G4StepPoint* preStepPoint = aStep->GetPreStepPoint();
+    const G4VTouchable* theTouchable = preStepPoint->GetTouchable();
+    const G4Track* track = aStep->GetTrack();
+    G4ThreeVector prePosition = preStepPoint->GetPosition();
+
+    // Getting volume information; the normal is found in the volume's
+    // frame and turned back into the global frame of the momentum
+    const BoundaryCache::Entry& boundary = fBoundaries.Get(theTouchable->GetVolume()->GetLogicalVolume());
+    const G4AffineTransform& transform = theTouchable->GetHistory()->GetTopTransform();
+    G4ThreeVector localPosition = transform.TransformPoint(prePosition);
+    G4ThreeVector surfNorm = transform.InverseTransformAxis(fBoundaries.GetNormal(boundary, localPosition));
+    G4double areaS = boundary.halfArea/mm2;
+
+    BDCrossing * aBdx = new BDCrossing();
+    aBdx->SetPDG(track->GetParticleDefinition()->GetPDGEncoding());
+    aBdx->SetDetID(detid);
+    aBdx->SetVertex(track->GetVertexPosition());
+    aBdx->SetPosition(prePosition);
+    aBdx->SetEnergy(track->GetTotalEnergy());
+    aBdx->SetMomentum(track->GetMomentum());
+    aBdx->SetAngle(surfNorm);
+    aBdx->SetFluence(surfNorm, areaS);
+    aBdx->SetCreatorProcess(ProcessRegistry::GetCreatorID(track));
+    aBdx->SetWeight(track->GetWeight());
+    fBDXCollection->insert(aBdx);
+}
+
+Hit* SensitiveDetector::NewHit(const G4Step* aStep, G4int detid, const G4ThreeVector& position, G4double edep,
+                               G4double weight) const {
+
+    const G4Track* track = aStep->GetTrack();
 
     class Hit* aHit = new class Hit(); // class keyword needs to be added as 'Hit'
                                        // is also an inline function within this scope.
     aHit->AddPosition(position);
     aHit->AddEdep(edep);
-    aHit->AddParticleType(pdgCode);
-    aHit->AddVertexPosition(vpos);
-    aHit->AddEnergy(energy);
+    aHit->AddParticleType(track->GetParticleDefinition()->GetPDGEncoding());
+    aHit->AddProcess(ProcessRegistry::GetCreatorID(track));
+    aHit->AddVertexPosition(track->GetVertexPosition());
+    aHit->AddEnergy(track->GetTotalEnergy());
     aHit->AddDetectorID(detid);
-    aHit->AddTrackID(trackid);
-    fHitCollection->insert(aHit);
+    aHit->AddTrackID(track->GetTrackID());
+    aHit->AddWeight(weight);
+    return aHit;
+}
 
-    return true;
+G4bool SensitiveDetector::KeepsCompactHits(G4int summaryDetector) {
+    return summaryDetector == kSummaryLanex || summaryDetector == kSummaryGSpec;
 }
 
-void SensitiveDetector::EndOfEvent(G4HCofThisEvent* HCE) {
-    
-    G4RootAnalysisManager* analysisManager = G4RootAnalysisManager::Instance();
-    G4RunManager* runManager = G4RunManager::GetRunManager();
-
-    G4int nhits = fHitCollection->entries();
-    for (G4int ii = 0; ii < nhits; ++ii) {
-        auto hit = (*fHitCollection)[ii];
-
-        G4int pdg          = hit->GetParticleType();
-        G4int procid       = hit->GetProcess();
-        G4int detid        = hit->GetDetectorID();
-        G4int trackid      = hit->GetTrackID();
-        G4double x         = hit->GetPosition().x();
-        G4double y         = hit->GetPosition().y();
-        G4double z         = hit->GetPosition().z();
-        G4double vtxx      = hit->GetVertexPosition().x();
-        G4double vtxy      = hit->GetVertexPosition().y();
-        G4double vtxz      = hit->GetVertexPosition().z();
-        G4double edep      = hit->GetEdep();
-        G4double energy    = hit->GetEnergy();
-
-        analysisManager->FillNtupleIColumn(0, 0, runManager->GetCurrentEvent()->GetEventID());
-        analysisManager->FillNtupleDColumn(0, 1, x/mm);
-        analysisManager->FillNtupleDColumn(0, 2, y/mm);
-        analysisManager->FillNtupleDColumn(0, 3, z/mm);
-        analysisManager->FillNtupleDColumn(0, 4, vtxx/mm);
-        analysisManager->FillNtupleDColumn(0, 5, vtxy/mm);
-        analysisManager->FillNtupleDColumn(0, 6, vtxz/mm);
-        analysisManager->FillNtupleDColumn(0, 7, edep/MeV);
-        analysisManager->FillNtupleDColumn(0, 8, energy/MeV);
-        analysisManager->FillNtupleIColumn(0, 9, pdg);
-        analysisManager->FillNtupleIColumn(0, 10, procid);
-        analysisManager->FillNtupleIColumn(0, 11, detid);
-        analysisManager->FillNtupleIColumn(0, 12, trackid);
-        analysisManager->AddNtupleRow(0);
+G4int SensitiveDetector::GetFirstHitColumn(G4int summaryDetector) {
+    G4int column = 1;
+    for (G4int dd = 0; dd < summaryDetector; ++dd) {
+        column += KeepsCompactHits(dd) ? kCompactHitColumnsPerDetector : kHitColumnsPerDetector;
+    }
+    return column;
+}
+
+template<class HitType>
+void SensitiveDetector::FillHitRow(G4int evid, const HitType* hit) const {
+
+    OutputBatch* batch = OutputManager::Instance()->GetBatch();
+
+    batch->FillNtupleIColumn(0, 0, evid);
+    batch->FillNtupleDColumn(0, 1, hit->GetPosition().x()/mm);
+    batch->FillNtupleDColumn(0, 2, hit->GetPosition().y()/mm);
+    batch->FillNtupleDColumn(0, 3, hit->GetPosition().z()/mm);
+    batch->FillNtupleDColumn(0, 4, hit->GetVertexPosition().x()/mm);
+    batch->FillNtupleDColumn(0, 5, hit->GetVertexPosition().y()/mm);
+    batch->FillNtupleDColumn(0, 6, hit->GetVertexPosition().z()/mm);
+    batch->FillNtupleDColumn(0, 7, hit->GetEdep()/MeV);
+    batch->FillNtupleDColumn(0, 8, hit->GetEnergy()/MeV);
+    batch->FillNtupleIColumn(0, 9, hit->GetParticleType());
+    batch->FillNtupleIColumn(0, 10, hit->GetProcess());
+    batch->FillNtupleIColumn(0, 11, hit->GetDetectorID());
+    batch->FillNtupleIColumn(0, 12, hit->GetTrackID());
+    batch->FillNtupleDColumn(0, 13, hit->GetWeight());
+    batch->AddNtupleRow(0);
+}
+
+template<class HitType>
+void SensitiveDetector::FillHitColumns(const std::vector<HitType*>& hits) const {
+
+    OutputBatch* batch = OutputManager::Instance()->GetBatch();
+    G4bool full = !KeepsCompactHits(fSummaryDetector);
+    G4int column = GetFirstHitColumn(fSummaryDetector);
+
+    // Columns in booking order; a compact block skips the full-hit ones
+    std::vector<G4double>& x       = batch->GetNtupleDVector(0, column++);
+    std::vector<G4double>& y       = batch->GetNtupleDVector(0, column++);
+    std::vector<G4double>& z       = batch->GetNtupleDVector(0, column++);
+    std::vector<G4double>* vtxx    = full ? &batch->GetNtupleDVector(0, column++) : 0;
+    std::vector<G4double>* vtxy    = full ? &batch->GetNtupleDVector(0, column++) : 0;
+    std::vector<G4double>* vtxz    = full ? &batch->GetNtupleDVector(0, column++) : 0;
+    std::vector<G4double>& edep    = batch->GetNtupleDVector(0, column++);
+    std::vector<G4double>* energy  = full ? &batch->GetNtupleDVector(0, column++) : 0;
+    std::vector<G4int>&    pdg     = batch->GetNtupleIVector(0, column++);
+    std::vector<G4int>*    procid  = full ? &batch->GetNtupleIVector(0, column++) : 0;
+    std::vector<G4int>&    detid   = batch->GetNtupleIVector(0, column++);
+    std::vector<G4int>&    trackid = batch->GetNtupleIVector(0, column++);
+    std::vector<G4double>& weight  = batch->GetNtupleDVector(0, column++);
+
+    for (std::size_t ii = 0; ii < hits.size(); ++ii) {
+        const HitType* hit = hits[ii];
+        x.push_back(hit->GetPosition().x()/mm);
+        y.push_back(hit->GetPosition().y()/mm);
+        z.push_back(hit->GetPosition().z()/mm);
+        edep.push_back(hit->GetEdep()/MeV);
+        pdg.push_back(hit->GetParticleType());
+        detid.push_back(hit->GetDetectorID());
+        trackid.push_back(hit->GetTrackID());
+        weight.push_back(hit->GetWeight());
+        if (!full) continue;
+        vtxx->push_back(hit->GetVertexPosition().x()/mm);
+        vtxy->push_back(hit->GetVertexPosition().y()/mm);
+        vtxz->push_back(hit->GetVertexPosition().z()/mm);
+        energy->push_back(hit->GetEnergy()/MeV);
+        procid->push_back(hit->GetProcess());
     }
+}
+
+template void SensitiveDetector::FillHitRow<Hit>(G4int, const Hit*) const;
+template void SensitiveDetector::FillHitRow<DepositHit>(G4int, const DepositHit*) const;
+template void SensitiveDetector::FillHitColumns<Hit>(const std::vector<Hit*>&) const;
+template void SensitiveDetector::FillHitColumns<DepositHit>(const std::vector<DepositHit*>&) const;
+
+void SensitiveDetector::EndOfEvent(G4HCofThisEvent* HCE) {
     
+    G4int evid = fEventAction->GetEventID();
+
+    // With aggregation each collection entry is already a merged hit
+    std::size_t nhits = FillHits(evid);
+    if (nhits > fHitCapacity) fHitCapacity = nhits;
 
     nhits = fBDXCollection->entries();
-    for (G4int ii = 0; ii < nhits; ++ii) {
-        auto bdx = (*fBDXCollection)[ii];
+    if (nhits > fBDXCapacity) fBDXCapacity = nhits;
+    if (fEventLayout) FillBdxColumns();
+    else FillBdxRows(evid);
+}
+
+void SensitiveDetector::FillBdxRows(G4int evid) const {
 
+    OutputBatch* batch = OutputManager::Instance()->GetBatch();
+
+    std::size_t nhits = fBDXCollection->entries();
+    for (std::size_t ii = 0; ii < nhits; ++ii) {
+        auto bdx = (*fBDXCollection)[ii];
         G4int pdg          = bdx->GetPDG();
         G4int detid        = bdx->GetDetID();
         G4int procid       = bdx->GetProcessID();
@@ -188,25 +302,71 @@ void SensitiveDetector::EndOfEvent(G4HCofThisEvent* HCE) {
         G4double energy    = bdx->GetEnergy();
         G4double theta     = bdx->GetAngle();
         G4double fluence   = bdx->GetFluence();
+        G4double weight    = bdx->GetWeight();
 
 
-        analysisManager->FillNtupleIColumn(4, 0, runManager->GetCurrentEvent()->GetEventID());
-        analysisManager->FillNtupleIColumn(4, 1, pdg);
-        analysisManager->FillNtupleIColumn(4, 2, detid);
-        analysisManager->FillNtupleIColumn(4, 3, procid);
-        analysisManager->FillNtupleDColumn(4, 4, x/mm);
-        analysisManager->FillNtupleDColumn(4, 5, y/mm);
-        analysisManager->FillNtupleDColumn(4, 6, z/mm);
-        analysisManager->FillNtupleDColumn(4, 7, vtxx/mm);
-        analysisManager->FillNtupleDColumn(4, 8, vtxy/mm);
-        analysisManager->FillNtupleDColumn(4, 9, vtxz/mm);
-        analysisManager->FillNtupleDColumn(4, 10, px/MeV);
-        analysisManager->FillNtupleDColumn(4, 11, py/MeV);
-        analysisManager->FillNtupleDColumn(4, 12, pz/MeV);
-        analysisManager->FillNtupleDColumn(4, 13, energy/MeV);
-        analysisManager->FillNtupleDColumn(4, 14, theta/rad);
-        analysisManager->FillNtupleDColumn(4, 15, fluence/(1/mm2));
-        analysisManager->AddNtupleRow(4);
+        batch->FillNtupleIColumn(4, 0, evid);
+        batch->FillNtupleIColumn(4, 1, pdg);
+        batch->FillNtupleIColumn(4, 2, detid);
+        batch->FillNtupleIColumn(4, 3, procid);
+        batch->FillNtupleDColumn(4, 4, x/mm);
+        batch->FillNtupleDColumn(4, 5, y/mm);
+        batch->FillNtupleDColumn(4, 6, z/mm);
+        batch->FillNtupleDColumn(4, 7, vtxx/mm);
+        batch->FillNtupleDColumn(4, 8, vtxy/mm);
+        batch->FillNtupleDColumn(4, 9, vtxz/mm);
+        batch->FillNtupleDColumn(4, 10, px/MeV);
+        batch->FillNtupleDColumn(4, 11, py/MeV);
+        batch->FillNtupleDColumn(4, 12, pz/MeV);
+        batch->FillNtupleDColumn(4, 13, energy/MeV);
+        batch->FillNtupleDColumn(4, 14, theta/rad);
+        batch->FillNtupleDColumn(4, 15, fluence/(1/mm2));
+        batch->FillNtupleDColumn(4, 16, weight);
+        batch->AddNtupleRow(4);
     }
 
 }
+
+void SensitiveDetector::FillBdxColumns() const {
+
+    OutputBatch* batch = OutputManager::Instance()->GetBatch();
+    G4int first = 1 + fSummaryDetector*kBdxColumnsPerDetector;
+
+    std::vector<G4int>&    pdg     = batch->GetNtupleIVector(4, first);
+    std::vector<G4int>&    detid   = batch->GetNtupleIVector(4, first + 1);
+    std::vector<G4int>&    procid  = batch->GetNtupleIVector(4, first + 2);
+    std::vector<G4double>& x       = batch->GetNtupleDVector(4, first + 3);
+    std::vector<G4double>& y       = batch->GetNtupleDVector(4, first + 4);
+    std::vector<G4double>& z       = batch->GetNtupleDVector(4, first + 5);
+    std::vector<G4double>& vtxx    = batch->GetNtupleDVector(4, first + 6);
+    std::vector<G4double>& vtxy    = batch->GetNtupleDVector(4, first + 7);
+    std::vector<G4double>& vtxz    = batch->GetNtupleDVector(4, first + 8);
+    std::vector<G4double>& px      = batch->GetNtupleDVector(4, first + 9);
+    std::vector<G4double>& py      = batch->GetNtupleDVector(4, first + 10);
+    std::vector<G4double>& pz      = batch->GetNtupleDVector(4, first + 11);
+    std::vector<G4double>& energy  = batch->GetNtupleDVector(4, first + 12);
+    std::vector<G4double>& theta   = batch->GetNtupleDVector(4, first + 13);
+    std::vector<G4double>& fluence = batch->GetNtupleDVector(4, first + 14);
+    std::vector<G4double>& weight  = batch->GetNtupleDVector(4, first + 15);
+
+    std::size_t nhits = fBDXCollection->entries();
+    for (std::size_t ii = 0; ii < nhits; ++ii) {
+        const BDCrossing* bdx = (*fBDXCollection)[ii];
+        pdg.push_back(bdx->GetPDG());
+        detid.push_back(bdx->GetDetID());
+        procid.push_back(bdx->GetProcessID());
+        x.push_back(bdx->GetPosition().x()/mm);
+        y.push_back(bdx->GetPosition().y()/mm);
+        z.push_back(bdx->GetPosition().z()/mm);
+        vtxx.push_back(bdx->GetVertex().x()/mm);
+        vtxy.push_back(bdx->GetVertex().y()/mm);
+        vtxz.push_back(bdx->GetVertex().z()/mm);
+        px.push_back(bdx->GetMomentum().x()/MeV);
+        py.push_back(bdx->GetMomentum().y()/MeV);
+        pz.push_back(bdx->GetMomentum().z()/MeV);
+        energy.push_back(bdx->GetEnergy()/MeV);
+        theta.push_back(bdx->GetAngle()/rad);
+        fluence.push_back(bdx->GetFluence()/(1/mm2));
+        weight.push_back(bdx->GetWeight());
+    }
+}
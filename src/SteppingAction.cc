@@ -3,22 +3,50 @@
 // Geometry has been derived from the FLUKA simulation of the same experiment.
 // 
 // Source file for SteppingAction class
-// Last edited: 11/02/2022
+// Last edited: 17/10/2026
 //
 
 #include "SteppingAction.hh"
-#include "EventAction.hh"
+#include "PhaseSpaceWriter.hh"
+#include "ScoringMeshManager.hh"
+#include "ScreenImager.hh"
+#include "Cr39Scorer.hh"
+#include "TrackLengthFluence.hh"
+#include "EnergyLedger.hh"
+#include "MuonTruthStore.hh"
 
 #include "G4Event.hh"
 #include "G4Step.hh"
+#include "G4Track.hh"
 
-SteppingAction::SteppingAction(EventAction* eventAction) : G4UserSteppingAction(), fEventAction(eventAction)
+SteppingAction::SteppingAction() : G4UserSteppingAction(), fPhaseSpaceWriter(PhaseSpaceWriter::Instance()),
+                                   fMeshManager(ScoringMeshManager::Instance()),
+                                   fScreenImager(ScreenImager::Instance()),
+                                   fCr39Scorer(Cr39Scorer::Instance()),
+                                   fFluence(TrackLengthFluence::Instance()),
+                                   fLedger(EnergyLedger::Instance()),
+                                   fMuonTruth(MuonTruthStore::Instance())
 {}
 
 SteppingAction::~SteppingAction()
 {}
 
 void SteppingAction::UserSteppingAction(const G4Step* aStep) {
-    G4double edep = aStep->GetTotalEnergyDeposit()/CLHEP::keV;
-    fEventAction->AddEdep(edep);
+    // Energy budget per volume; also sums the event's deposit
+    fLedger->Score(aStep);
+
+    if (fMeshManager->HasMeshes()) fMeshManager->Score(aStep);
+    if (fScreenImager->IsEnabled()) fScreenImager->Score(aStep);
+    if (fCr39Scorer->IsEnabled()) fCr39Scorer->Score(aStep);
+    if (fFluence->IsEnabled()) fFluence->Score(aStep);
+    if (fMuonTruth->IsEnabled()) fMuonTruth->Score(aStep);
+
+    // Phase-space recording of forward crossings of the scoring plane
+    if (fPhaseSpaceWriter->IsRecording() && fPhaseSpaceWriter->IsForwardCrossing(aStep)) {
+        fPhaseSpaceWriter->Record(aStep);
+        if (fPhaseSpaceWriter->GetKillAtPlane()) {
+            aStep->GetTrack()->SetTrackStatus(fStopAndKill);
+            fLedger->AddKilled(aStep);
+        }
+    }
 }
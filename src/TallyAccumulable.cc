@@ -0,0 +1,58 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for TallyAccumulable class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cmath>
+#include <limits>
+
+#include "TallyAccumulable.hh"
+
+TallyAccumulable::TallyAccumulable() : G4VAccumulable("tallies"), fEvents(0.)
+{}
+
+TallyAccumulable::~TallyAccumulable()
+{}
+
+void TallyAccumulable::Merge(const G4VAccumulable& other) {
+    const TallyAccumulable& tallies = static_cast<const TallyAccumulable&>(other);
+    fEvents += tallies.fEvents;
+    for (std::size_t ii = 0; ii < fSum.size() && ii < tallies.fSum.size(); ++ii) {
+        fSum[ii] += tallies.fSum[ii];
+        fSum2[ii] += tallies.fSum2[ii];
+    }
+}
+
+void TallyAccumulable::Reset() {
+    fEvents = 0.;
+    fSum.assign(fSum.size(), 0.);
+    fSum2.assign(fSum2.size(), 0.);
+}
+
+void TallyAccumulable::Resize(std::size_t ntallies) {
+    fEvents = 0.;
+    fSum.assign(ntallies, 0.);
+    fSum2.assign(ntallies, 0.);
+}
+
+void TallyAccumulable::Fill(const std::vector<G4double>& values) {
+    fEvents += 1.;
+    for (std::size_t ii = 0; ii < fSum.size(); ++ii) {
+        fSum[ii] += values[ii];
+        fSum2[ii] += values[ii]*values[ii];
+    }
+}
+
+G4double TallyAccumulable::RelativeError(G4double nn, G4double sum, G4double sum2) {
+
+    // Infinite until the mean is known to be non-zero
+    if (nn < 2. || sum == 0.) return std::numeric_limits<G4double>::infinity();
+    G4double mean = sum/nn;
+    G4double variance = (sum2/nn - mean*mean)*nn/(nn - 1.);
+    if (variance < 0.) variance = 0.;
+    return std::sqrt(variance/nn)/std::abs(mean);
+}
@@ -0,0 +1,196 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for TrackLengthFluence class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "TrackLengthFluence.hh"
+#include "TrackLengthFluenceMessenger.hh"
+#include "OutputManager.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VSolid.hh"
+#include "G4SystemOfUnits.hh"
+
+TrackLengthFluence* TrackLengthFluence::Instance() {
+    static TrackLengthFluence theFluence;
+    return &theFluence;
+}
+
+TrackLengthFluence::TrackLengthFluence() : fMessenger(0), fEnabled(false), fNEnergy(120), fEnergyMin(1.*keV),
+                                           fEnergyMax(10.*GeV), fLogEnergyMin(0.), fEnergyBinsPerDecade(0.) {
+
+    // YAG screens and LANEX phosphor
+    fVolumeNames.insert("lYagScreen");
+    fVolumeNames.insert("lPhosphorLayer");
+
+    fMessenger = new TrackLengthFluenceMessenger(this);
+}
+
+TrackLengthFluence::~TrackLengthFluence() {
+    ClearDetectors();
+    delete fMessenger;
+}
+
+void TrackLengthFluence::ClearDetectors() {
+    for (std::size_t ii = 0; ii < fDetectors.size(); ++ii) delete fDetectors[ii];
+    fDetectors.clear();
+    fSlots.clear();
+}
+
+void TrackLengthFluence::CountPlacements(const G4LogicalVolume* mother, G4int count, std::vector<G4int>& counts) const {
+
+    // Every daughter is placed once per placement of its mother, times its
+    // own multiplicity for replicas
+    for (std::size_t ii = 0; ii < mother->GetNoDaughters(); ++ii) {
+        const G4VPhysicalVolume* daughter = mother->GetDaughter(ii);
+        const G4LogicalVolume* logical = daughter->GetLogicalVolume();
+        G4int placements = count*daughter->GetMultiplicity();
+
+        std::size_t index = logical->GetInstanceID();
+        if (index >= counts.size()) counts.resize(index + 1, 0);
+        counts[index] += placements;
+        CountPlacements(logical, placements, counts);
+    }
+}
+
+void TrackLengthFluence::BeginOfRun() {
+
+    ClearDetectors();
+    if (!fEnabled) return;
+
+    // Number of times each logical volume appears in the geometry tree
+    std::vector<G4int> counts;
+    const G4PhysicalVolumeStore* store = G4PhysicalVolumeStore::GetInstance();
+    for (std::size_t ii = 0; ii < store->size(); ++ii) {
+        const G4VPhysicalVolume* volume = (*store)[ii];
+        if (volume->GetMotherLogical()) continue;
+
+        const G4LogicalVolume* world = volume->GetLogicalVolume();
+        std::size_t index = world->GetInstanceID();
+        if (index >= counts.size()) counts.resize(index + 1, 0);
+        counts[index] += 1;
+        CountPlacements(world, 1, counts);
+    }
+
+    std::set<G4String> found;
+    const G4LogicalVolumeStore* logicalStore = G4LogicalVolumeStore::GetInstance();
+    for (std::size_t ii = 0; ii < logicalStore->size(); ++ii) {
+        G4LogicalVolume* logical = (*logicalStore)[ii];
+        if (fVolumeNames.find(logical->GetName()) == fVolumeNames.end()) continue;
+
+        std::size_t index = logical->GetInstanceID();
+        G4int placements = (index < counts.size()) ? counts[index] : 0;
+        if (placements == 0) continue;
+        found.insert(logical->GetName());
+
+        Detector* detector = new Detector();
+        detector->name = logical->GetName();
+        detector->scale = cm3/(placements*logical->GetSolid()->GetCubicVolume());
+        detector->fluence.Resize(static_cast<std::size_t>(kFluenceNSpecies)*fNEnergy);
+
+        if (index >= fSlots.size()) fSlots.resize(index + 1, -1);
+        fSlots[index] = fDetectors.size();
+        fDetectors.push_back(detector);
+    }
+    for (std::set<G4String>::const_iterator it = fVolumeNames.begin(); it != fVolumeNames.end(); ++it) {
+        if (found.find(*it) != found.end()) continue;
+        G4ExceptionDescription msg;
+        msg << "Fluence volume " << *it << " is not placed in the geometry and is not scored.";
+        G4Exception("TrackLengthFluence::BeginOfRun", "Apollon022", JustWarning, msg);
+    }
+
+    fLogEnergyMin = std::log10(fEnergyMin);
+    fEnergyBinsPerDecade = fNEnergy/(std::log10(fEnergyMax) - fLogEnergyMin);
+}
+
+void TrackLengthFluence::ResetLocal() {
+    for (std::size_t ii = 0; ii < fDetectors.size(); ++ii) fDetectors[ii]->fluence.ResetLocal();
+}
+
+void TrackLengthFluence::Merge() {
+    for (std::size_t ii = 0; ii < fDetectors.size(); ++ii) fDetectors[ii]->fluence.Merge();
+}
+
+void TrackLengthFluence::Score(const G4Step* aStep) const {
+
+    const G4StepPoint* preStepPoint = aStep->GetPreStepPoint();
+    std::size_t index = preStepPoint->GetPhysicalVolume()->GetLogicalVolume()->GetInstanceID();
+    if (index >= fSlots.size() || fSlots[index] < 0) return;
+
+    G4double length = aStep->GetStepLength();
+    if (length <= 0.) return;
+
+    // Binned at the energy the track has on entering the step; energies
+    // outside the range are not scored
+    G4double energy = preStepPoint->GetKineticEnergy();
+    if (energy < fEnergyMin || energy >= fEnergyMax) return;
+    G4int energyBin = static_cast<G4int>((std::log10(energy) - fLogEnergyMin)*fEnergyBinsPerDecade);
+    if (energyBin >= fNEnergy) energyBin = fNEnergy - 1;
+
+    G4int species = kFluenceOther;
+    switch (std::abs(aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding())) {
+        case 22:   species = kFluenceGamma; break;
+        case 13:   species = kFluenceMuon; break;
+        case 2212: species = kFluenceProton; break;
+        case 2112: species = kFluenceNeutron; break;
+        case 11:
+            species = (aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding() > 0) ? kFluenceElectron
+                                                                                         : kFluencePositron;
+            break;
+        default: break;
+    }
+
+    const Detector* detector = fDetectors[fSlots[index]];
+    detector->fluence.Add(static_cast<std::size_t>(species)*fNEnergy + energyBin,
+                          preStepPoint->GetWeight()*(length/cm)*detector->scale);
+}
+
+void TrackLengthFluence::Write(G4int nEvents) const {
+
+    for (std::size_t ii = 0; ii < fDetectors.size(); ++ii) {
+        const Detector* detector = fDetectors[ii];
+
+        ScoreFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.rank = 2;
+        header.shape[0] = kFluenceNSpecies;
+        header.shape[1] = fNEnergy;
+        header.upper[0] = kFluenceNSpecies;
+        header.lower[1] = fEnergyMin/MeV;
+        header.upper[1] = fEnergyMax/MeV;
+        header.logAxes = 1 << 1;
+        header.nEvents = nEvents;
+        std::strncpy(header.quantity, "fluence", sizeof(header.quantity) - 1);
+        std::strncpy(header.unit, "1/cm2", sizeof(header.unit) - 1);
+
+        G4String fname = OutputManager::Instance()->GetRunFileName("fluence_" + detector->name + ".score");
+        if (detector->fluence.Write(fname, header)) {
+            G4cout << "Track-length fluence " << fname << " written (" << fNEnergy << " energy bins)." << G4endl;
+        }
+    }
+}
+
+void TrackLengthFluence::SetEnabled(G4bool val) { fEnabled = val; }
+
+void TrackLengthFluence::AddVolume(const G4String& volume) { fVolumeNames.insert(volume); }
+
+void TrackLengthFluence::SetEnergyBinning(G4int nbins, G4double energyMin, G4double energyMax) {
+    fNEnergy = nbins;
+    fEnergyMin = energyMin;
+    fEnergyMax = energyMax;
+}
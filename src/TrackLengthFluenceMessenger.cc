@@ -0,0 +1,78 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for TrackLengthFluenceMessenger class
+// Last edited: 17/10/2026
+//
+
+#include <sstream>
+
+#include "TrackLengthFluenceMessenger.hh"
+#include "TrackLengthFluence.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4SystemOfUnits.hh"
+
+TrackLengthFluenceMessenger::TrackLengthFluenceMessenger(TrackLengthFluence* fluence) : G4UImessenger(),
+                                                                                      fFluence(fluence) {
+
+    fDirectory = new G4UIdirectory("/fluence/");
+    fDirectory->SetGuidance("Track-length fluence spectra in detector volumes.");
+
+    fScoreCmd = new G4UIcmdWithABool("/fluence/score", this);
+    fScoreCmd->SetGuidance("Score fluence by species and energy, written to fluence_<volume>.score at the end of each run.");
+    fScoreCmd->SetParameterName("score", false);
+    fScoreCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fScoreCmd->SetToBeBroadcasted(false);
+
+    fVolumeCmd = new G4UIcmdWithAString("/fluence/volume", this);
+    fVolumeCmd->SetGuidance("Add a logical volume to the scored detectors (lYagScreen and lPhosphorLayer by default).");
+    fVolumeCmd->SetParameterName("volume", false);
+    fVolumeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fVolumeCmd->SetToBeBroadcasted(false);
+
+    fEnergyBinsCmd = new G4UIcommand("/fluence/energyBins", this);
+    fEnergyBinsCmd->SetGuidance("Set the logarithmic kinetic energy binning: number of bins, lower and upper edge in MeV.");
+    G4UIparameter* nbins = new G4UIparameter("nbins", 'i', false);
+    nbins->SetParameterRange("nbins>0");
+    fEnergyBinsCmd->SetParameter(nbins);
+    G4UIparameter* energyMin = new G4UIparameter("energyMin", 'd', false);
+    energyMin->SetParameterRange("energyMin>0.");
+    fEnergyBinsCmd->SetParameter(energyMin);
+    G4UIparameter* energyMax = new G4UIparameter("energyMax", 'd', false);
+    energyMax->SetParameterRange("energyMax>0.");
+    fEnergyBinsCmd->SetParameter(energyMax);
+    fEnergyBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEnergyBinsCmd->SetToBeBroadcasted(false);
+}
+
+TrackLengthFluenceMessenger::~TrackLengthFluenceMessenger() {
+    delete fDirectory;
+    delete fScoreCmd;
+    delete fVolumeCmd;
+    delete fEnergyBinsCmd;
+}
+
+void TrackLengthFluenceMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+    if (command == fScoreCmd) fFluence->SetEnabled(fScoreCmd->GetNewBoolValue(newValue));
+    if (command == fVolumeCmd) fFluence->AddVolume(newValue);
+    if (command == fEnergyBinsCmd) {
+        std::istringstream iss(newValue);
+        G4int nbins;
+        G4double energyMin, energyMax;
+        iss >> nbins >> energyMin >> energyMax;
+        if (energyMax <= energyMin) {
+            G4Exception("TrackLengthFluenceMessenger::SetNewValue", "Apollon023", JustWarning,
+                        "Upper energy edge must exceed the lower edge; binning unchanged.");
+            return;
+        }
+        fFluence->SetEnergyBinning(nbins, energyMin*MeV, energyMax*MeV);
+    }
+
+}
@@ -6,101 +6,103 @@
 // Last edited: 16/02/2022
 // *
 
+#include <cstdlib>
+
 #include "TrackingAction.hh"
 #include "RunAction.hh"
+#include "EventAction.hh"
+#include "SeedStore.hh"
+#include "DetectorConstruction.hh"
+#include "DetectorIDTable.hh"
+#include "ProcessRegistry.hh"
+#include "MuonTruthStore.hh"
+#include "OutputManager.hh"
+#include "OutputBatch.hh"
 
 #include "G4Track.hh"
 #include "G4ThreeVector.hh"
 #include "G4VProcess.hh"
-#include "G4EmProcessSubType.hh"
 #include "G4SystemOfUnits.hh"
 
-#include "G4RootAnalysisManager.hh"
 #include "G4RunManager.hh"
+#include "G4TrackingManager.hh"
 
-TrackingAction::TrackingAction(RunAction*) : G4UserTrackingAction()
-{}
+TrackingAction::TrackingAction(RunAction*, EventAction* eventAction) : G4UserTrackingAction(),
+                                                                      fEventAction(eventAction), fDetectorIDs(0) {
+
+    // Detector construction is shared with the master
+    const DetectorConstruction* detector =
+        static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    fDetectorIDs = detector->GetDetectorIDTable();
+}
 
 TrackingAction::~TrackingAction()
 {}
 
-void TrackingAction::PreUserTrackingAction(const G4Track*) 
-{}
+void TrackingAction::PreUserTrackingAction(const G4Track* track) {
+
+    // Flags events worth replaying from the seed store
+    if (std::abs(track->GetParticleDefinition()->GetPDGEncoding()) == 13) fEventAction->AddFlag(kMuonCreated);
+
+    // Compact record of every track, pruned to muon ancestors at the end of the event
+    MuonTruthStore* muonTruth = MuonTruthStore::Instance();
+    if (muonTruth->IsEnabled()) muonTruth->AddTrack(track);
+
+    // Replayed events keep the trajectory of every track
+    if (SeedStore::Instance()->IsReplaying()) fpTrackingManager->SetStoreTrajectory(1);
+}
 
 void TrackingAction::PostUserTrackingAction(const G4Track* track) {
 
-    // Get detector ID; return if not in a sensitive volume
+    // Get detector ID; return if not in a sensitive volume, unless the
+    // event is being replayed, in which case every track is written
     const G4StepPoint* preStepPoint = track->GetStep()->GetPreStepPoint();
-    const G4String& logicName = preStepPoint->GetPhysicalVolume()->GetLogicalVolume()->GetName();
-    G4int ldet = 0;
-    if (logicName == "lYagScreen") {
-        ldet = 1000;
-    }
-    else if (logicName == "lStack") {
-        ldet = 2000;
-    }
-    else if (logicName == "lLanexSheet") {
-        ldet = 3000;
-    }
-    else {
-        return;
-    }
+    G4bool replaying = SeedStore::Instance()->IsReplaying();
+    G4int ldet = fDetectorIDs->GetTrackID(preStepPoint->GetPhysicalVolume()->GetLogicalVolume());
+    if (ldet == DetectorIDTable::kNoDetector && !replaying) return;
 
-    G4int detid = ldet + preStepPoint->GetPhysicalVolume()->GetCopyNo() + 1;    
+    G4int detid = (ldet != DetectorIDTable::kNoDetector) ? ldet + preStepPoint->GetPhysicalVolume()->GetCopyNo() + 1 : 0;    
     G4int trackid = track->GetTrackID();
     G4int pdg = track->GetParticleDefinition()->GetPDGEncoding();
-    G4int procid = 2000;
+    G4int procid = ProcessRegistry::GetCreatorID(track);
     G4ThreeVector primaryVertex = track->GetVertexPosition();
     G4ThreeVector endVertex = track->GetPosition();
     G4double kEnergy = track->GetVertexKineticEnergy()/MeV;
+    G4double weight = track->GetWeight();
 
-    // Creator process ID
-    if (trackid != 1) {
-        const G4String& creatorProcess = track->GetCreatorProcess()->GetProcessName();
-        G4int id = 0;
-        if (creatorProcess == "CoulombScat") id = fCoulombScattering;
-        if (creatorProcess == "eIoni") id = fIonisation; 
-        if (creatorProcess == "eBrem") id = fBremsstrahlung;
-        if (creatorProcess == "muBrems") id = 16; //fMuBremsstrahlung;
-        if (creatorProcess == "ppCharged") id = fPairProdByCharged;
-        if (creatorProcess == "annihil") id = fAnnihilation; 
-        if (creatorProcess == "AnnihiToMuPair") id = fAnnihilationToMuMu;
-        if (creatorProcess == "hAnnihil") id = fAnnihilationToHadrons;
-        if (creatorProcess == "nuclearStopping") id = fNuclearStopping;
-        if (creatorProcess == "eGeneral") id = fElectronGeneralProcess;
-
-        if (creatorProcess == "msc") id = fMultipleScattering;
-        
-        if (creatorProcess == "Rayl") id = fRayleigh;
-        if (creatorProcess == "phot") id = fPhotoElectricEffect;
-        if (creatorProcess == "compt") id = fComptonScattering;
-        if (creatorProcess == "conv") id = fGammaConversion;
-        if (creatorProcess == "GammaToMuPair") id = fGammaConversionToMuMu;
-        if (creatorProcess == "gGeneral") id = fGammaGeneralProcess;
-        
-        if (creatorProcess == "Cherenkov") id = fCerenkov;
-        if (creatorProcess == "Scintillation") id = fScintillation;
-        if (creatorProcess == "SynRad") id = fSynchrotronRadiation;
-        if (creatorProcess == "TR") id = fTransitionRadiation;
-
-        procid = 2000 + id;
+    OutputManager* outputManager = OutputManager::Instance();
+    OutputBatch* batch = outputManager->GetBatch();
+
+    // Event layout: the track joins the vectors of the event's TrackEvents row
+    if (outputManager->IsEventLayout()) {
+        batch->GetNtupleIVector(2, kTrackColumnID).push_back(trackid);
+        batch->GetNtupleIVector(2, kTrackColumnPDG).push_back(pdg);
+        batch->GetNtupleIVector(2, kTrackColumnDetID).push_back(detid);
+        batch->GetNtupleIVector(2, kTrackColumnProcID).push_back(procid);
+        batch->GetNtupleDVector(2, kTrackColumnVtxX).push_back(primaryVertex.x()/mm);
+        batch->GetNtupleDVector(2, kTrackColumnVtxY).push_back(primaryVertex.y()/mm);
+        batch->GetNtupleDVector(2, kTrackColumnVtxZ).push_back(primaryVertex.z()/mm);
+        batch->GetNtupleDVector(2, kTrackColumnEndX).push_back(endVertex.x()/mm);
+        batch->GetNtupleDVector(2, kTrackColumnEndY).push_back(endVertex.y()/mm);
+        batch->GetNtupleDVector(2, kTrackColumnEndZ).push_back(endVertex.z()/mm);
+        batch->GetNtupleDVector(2, kTrackColumnEnergy).push_back(kEnergy);
+        batch->GetNtupleDVector(2, kTrackColumnWeight).push_back(weight);
+        return;
     }
 
-    G4RootAnalysisManager* analysisManager = G4RootAnalysisManager::Instance();
-    G4RunManager* runManager = G4RunManager::GetRunManager();
-
-    analysisManager->FillNtupleIColumn(2, 0, runManager->GetCurrentEvent()->GetEventID());
-    analysisManager->FillNtupleIColumn(2, 1, trackid);
-    analysisManager->FillNtupleIColumn(2, 2, pdg);
-    analysisManager->FillNtupleIColumn(2, 3, detid);
-    analysisManager->FillNtupleIColumn(2, 4, procid);
-    analysisManager->FillNtupleDColumn(2, 5, primaryVertex.x()/mm);
-    analysisManager->FillNtupleDColumn(2, 6, primaryVertex.y()/mm);
-    analysisManager->FillNtupleDColumn(2, 7, primaryVertex.z()/mm);
-    analysisManager->FillNtupleDColumn(2, 8, endVertex.x()/mm);
-    analysisManager->FillNtupleDColumn(2, 9, endVertex.y()/mm);
-    analysisManager->FillNtupleDColumn(2, 10, endVertex.z()/mm);
-    analysisManager->FillNtupleDColumn(2, 11, kEnergy);
-    analysisManager->AddNtupleRow(2);
+    batch->FillNtupleIColumn(2, 0, fEventAction->GetEventID());
+    batch->FillNtupleIColumn(2, kTrackColumnID, trackid);
+    batch->FillNtupleIColumn(2, kTrackColumnPDG, pdg);
+    batch->FillNtupleIColumn(2, kTrackColumnDetID, detid);
+    batch->FillNtupleIColumn(2, kTrackColumnProcID, procid);
+    batch->FillNtupleDColumn(2, kTrackColumnVtxX, primaryVertex.x()/mm);
+    batch->FillNtupleDColumn(2, kTrackColumnVtxY, primaryVertex.y()/mm);
+    batch->FillNtupleDColumn(2, kTrackColumnVtxZ, primaryVertex.z()/mm);
+    batch->FillNtupleDColumn(2, kTrackColumnEndX, endVertex.x()/mm);
+    batch->FillNtupleDColumn(2, kTrackColumnEndY, endVertex.y()/mm);
+    batch->FillNtupleDColumn(2, kTrackColumnEndZ, endVertex.z()/mm);
+    batch->FillNtupleDColumn(2, kTrackColumnEnergy, kEnergy);
+    batch->FillNtupleDColumn(2, kTrackColumnWeight, weight);
+    batch->AddNtupleRow(2);
 
 }
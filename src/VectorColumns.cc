@@ -0,0 +1,89 @@
+//
+// GEANT4 simulation of the Apollon 2022 experiment.
+// Geometry has been derived from the FLUKA simulation of the same experiment.
+// 
+// Source file for VectorColumns class
+//
+// Created: 17/10/2026
+// Last edited: 17/10/2026
+//
+#include "VectorColumns.hh"
+#include "OutputBatch.hh"
+
+#include "G4VAnalysisManager.hh"
+
+VectorColumns::VectorColumns()
+{}
+
+VectorColumns::~VectorColumns() {
+    for (std::size_t ii = 0; ii < fBindings.size(); ++ii) delete fBindings[ii];
+    for (std::size_t ii = 0; ii < fRetired.size(); ++ii) delete fRetired[ii];
+}
+
+G4int VectorColumns::CreateIColumn(G4VAnalysisManager* analysisManager, G4int ntupleId, const G4String& name) {
+
+    Binding* binding = new Binding();
+    binding->ntuple = ntupleId;
+    binding->real = false;
+    binding->column = analysisManager->CreateNtupleIColumn(ntupleId, name, binding->ints);
+    fBindings.push_back(binding);
+    return binding->column;
+}
+
+G4int VectorColumns::CreateRealColumn(G4VAnalysisManager* analysisManager, G4int ntupleId, const G4String& name,
+                                      const ColumnFormat& format) {
+
+    Binding* binding = new Binding();
+    binding->ntuple = ntupleId;
+    binding->real = true;
+    binding->format = format;
+    if (format.storage == kStoreFloat) {
+        binding->column = analysisManager->CreateNtupleFColumn(ntupleId, name, binding->floats);
+    }
+    else if (format.storage == kStoreFixed) {
+        binding->column = analysisManager->CreateNtupleIColumn(ntupleId, name, binding->ints);
+    }
+    else {
+        binding->column = analysisManager->CreateNtupleDColumn(ntupleId, name, binding->doubles);
+    }
+    fBindings.push_back(binding);
+    return binding->column;
+}
+
+void VectorColumns::BeginOfRun() {
+    fRetired.insert(fRetired.end(), fBindings.begin(), fBindings.end());
+    fBindings.clear();
+}
+
+void VectorColumns::Load(G4int ntupleId, const OutputBatch& batch) {
+
+    // A column the batch has no values for is written empty
+    for (std::size_t ii = 0; ii < fBindings.size(); ++ii) {
+        Binding* binding = fBindings[ii];
+        if (binding->ntuple != ntupleId) continue;
+
+        if (!binding->real) {
+            const std::vector<G4int>* values = batch.FindNtupleIVector(ntupleId, binding->column);
+            if (values) binding->ints.assign(values->begin(), values->end());
+            else binding->ints.clear();
+            continue;
+        }
+
+        const std::vector<G4double>* values = batch.FindNtupleDVector(ntupleId, binding->column);
+        std::size_t nvalues = values ? values->size() : 0;
+        if (binding->format.storage == kStoreFloat) {
+            binding->floats.resize(nvalues);
+            for (std::size_t jj = 0; jj < nvalues; ++jj) binding->floats[jj] = static_cast<G4float>((*values)[jj]);
+        }
+        else if (binding->format.storage == kStoreFixed) {
+            binding->ints.resize(nvalues);
+            for (std::size_t jj = 0; jj < nvalues; ++jj) binding->ints[jj] = binding->format.Quantize((*values)[jj]);
+        }
+        else if (values) {
+            binding->doubles.assign(values->begin(), values->end());
+        }
+        else {
+            binding->doubles.clear();
+        }
+    }
+}